@@ -0,0 +1,144 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_BUILDOUTPUTTAIL_H
+#define ATTICA_BUILDOUTPUTTAIL_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include "buildservicejoboutput.h"
+#include "provider.h"
+
+namespace Attica
+{
+
+/**
+ * Follows the output of a build service job, like tail -f.
+ *
+ * Every interval() the output is fetched with
+ * Provider::requestBuildServiceJobOutput() and only the text appended since
+ * the previous poll is passed on through outputAppended(). If the server
+ * sent something that does not continue the previous output (e.g. a
+ * truncated log), the complete output is passed on through outputReset().
+ * Polling stops by itself once the output reports the job as completed or
+ * failed.
+ */
+class BuildOutputTail : public QObject
+{
+    Q_OBJECT
+
+public:
+    BuildOutputTail(const Provider &provider, const QString &jobId, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_jobId(jobId)
+        , m_requestRunning(false)
+        , m_finished(false)
+    {
+        m_timer.setInterval(5000);
+        connect(&m_timer, &QTimer::timeout, this, &BuildOutputTail::poll);
+    }
+
+    /// Milliseconds between two polls, 5 seconds by default
+    int interval() const { return m_timer.interval(); }
+    void setInterval(int msecs) { m_timer.setInterval(msecs); }
+
+    /// The number of characters delivered so far
+    int offset() const { return m_output.size(); }
+
+    /// The complete output received so far
+    QString output() const { return m_output; }
+
+    bool isFinished() const { return m_finished; }
+
+    /// Polls right away and then every interval() until the job is done
+    void start()
+    {
+        if (m_finished) {
+            return;
+        }
+        m_timer.start();
+        poll();
+    }
+
+    void stop() { m_timer.stop(); }
+
+Q_SIGNALS:
+    void outputAppended(const QString &text);
+    void outputReset(const QString &output);
+    /// The job completed or failed, no more output will follow
+    void finished(const Attica::BuildServiceJobOutput &output);
+    void pollFailed(const Attica::Metadata &metadata);
+
+private:
+    void poll()
+    {
+        if (m_requestRunning) {
+            return;
+        }
+        m_requestRunning = true;
+        ItemJob<BuildServiceJobOutput> *job = m_provider.requestBuildServiceJobOutput(m_jobId);
+        connect(job, &BaseJob::finished, this, [this](BaseJob *baseJob) {
+            m_requestRunning = false;
+            if (baseJob->metadata().error() != Metadata::NoError) {
+                emit pollFailed(baseJob->metadata());
+                return;
+            }
+            update(static_cast<ItemJob<BuildServiceJobOutput> *>(baseJob)->result());
+        });
+        job->start();
+    }
+
+    void update(const BuildServiceJobOutput &result)
+    {
+        const QString output = result.output();
+        if (output.startsWith(m_output)) {
+            if (output.size() > m_output.size()) {
+                const QString appended = output.mid(m_output.size());
+                m_output = output;
+                emit outputAppended(appended);
+            }
+        } else {
+            m_output = output;
+            emit outputReset(output);
+        }
+
+        if (result.isCompleted() || result.isFailed()) {
+            m_finished = true;
+            m_timer.stop();
+            emit finished(result);
+        }
+    }
+
+    Provider m_provider;
+    const QString m_jobId;
+    QTimer m_timer;
+    QString m_output;
+    bool m_requestRunning;
+    bool m_finished;
+};
+
+}
+
+#endif
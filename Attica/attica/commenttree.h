@@ -0,0 +1,209 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_COMMENTTREE_H
+#define ATTICA_COMMENTTREE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "comment.h"
+
+namespace Attica
+{
+
+/**
+ * A flat, parent indexed view of the comments returned by
+ * Provider::requestComments(), for driving tree models.
+ *
+ * Only the top levels of the thread are turned into nodes right away;
+ * deeper replies stay inside their parent Comment until expand() is called
+ * for it. Nodes are addressed by their index, and parent(), child(), row()
+ * and childCount() are constant time, so a QAbstractItemModel can map its
+ * QModelIndex internal ids straight to node indexes.
+ *
+ * childCount() only counts materialized replies, so the row count of a
+ * node never changes behind the model's back. The model reports
+ * hasChildren() and calls expand() from fetchMore(), wrapped in
+ * beginInsertRows(parent, 0, expandCount(node) - 1) and endInsertRows();
+ * setComments() and clear() go between beginResetModel() and
+ * endResetModel(), appendComments() between beginInsertRows() and
+ * endInsertRows() on the root.
+ */
+class CommentTree
+{
+public:
+    /**
+     * @param levels how many levels are materialized by setComments(),
+     * appendComments() and each expand()
+     */
+    explicit CommentTree(int levels = 2)
+        : m_levels(qMax(1, levels))
+    {
+    }
+
+    /// Replaces the tree with the top level @p comments
+    void setComments(const Comment::List &comments)
+    {
+        clear();
+        appendComments(comments);
+    }
+
+    /// Adds the top level @p comments, e.g. from the next page of requestComments()
+    void appendComments(const Comment::List &comments)
+    {
+        for (const Comment &comment : comments) {
+            const int node = addNode(comment, -1, m_topLevel.size(), 0);
+            m_topLevel.append(node);
+            materialize(node, m_levels - 1);
+        }
+    }
+
+    void clear()
+    {
+        m_nodes.clear();
+        m_topLevel.clear();
+        m_ids.clear();
+    }
+
+    /// The number of materialized nodes
+    int count() const { return m_nodes.size(); }
+
+    int topLevelCount() const { return m_topLevel.size(); }
+    int topLevel(int row) const { return m_topLevel.at(row); }
+
+    Comment comment(int node) const { return m_nodes.at(node).comment; }
+
+    /// The parent node, or -1 for top level comments
+    int parent(int node) const { return m_nodes.at(node).parent; }
+
+    /// The position of @p node among the children of its parent
+    int row(int node) const { return m_nodes.at(node).row; }
+
+    int depth(int node) const { return m_nodes.at(node).depth; }
+
+    /// The number of materialized replies, 0 until the node was expanded
+    int childCount(int node) const { return m_nodes.at(node).children.size(); }
+
+    /// Whether @p node has replies, materialized or not
+    bool hasChildren(int node) const
+    {
+        const Node &n = m_nodes.at(node);
+        return n.expanded ? !n.children.isEmpty() : !n.comment.children().isEmpty();
+    }
+
+    /// The number of rows expand() will insert below @p node
+    int expandCount(int node) const
+    {
+        const Node &n = m_nodes.at(node);
+        return n.expanded ? 0 : n.comment.children().size();
+    }
+
+    /// The number of replies as reported by the server, which may include replies that were not sent
+    int replyCount(int node) const
+    {
+        const Comment &comment = m_nodes.at(node).comment;
+        return qMax(comment.childCount(), comment.children().size());
+    }
+
+    /// The node of the reply at @p row, or -1 if the replies have not been expanded yet
+    int child(int node, int row) const
+    {
+        const Node &n = m_nodes.at(node);
+        return n.expanded && row < n.children.size() ? n.children.at(row) : -1;
+    }
+
+    bool isExpanded(int node) const { return m_nodes.at(node).expanded; }
+
+    /**
+     * Materializes the replies below @p node, down to the configured number of levels.
+     * Inserts expandCount() rows below @p node; see the class documentation.
+     * @return false if the replies were expanded already
+     */
+    bool expand(int node)
+    {
+        if (m_nodes.at(node).expanded) {
+            return false;
+        }
+        materialize(node, m_levels);
+        return true;
+    }
+
+    /// The node of the comment with @p id, or -1 if it is not materialized
+    int indexOf(const QString &id) const
+    {
+        return m_ids.value(id, -1);
+    }
+
+private:
+    struct Node {
+        Node() : parent(-1), row(0), depth(0), expanded(false) {}
+        Comment comment;
+        int parent;
+        int row;
+        int depth;
+        bool expanded;
+        QVector<int> children;
+    };
+
+    int addNode(const Comment &comment, int parent, int row, int depth)
+    {
+        Node node;
+        node.comment = comment;
+        node.parent = parent;
+        node.row = row;
+        node.depth = depth;
+        m_nodes.append(node);
+        m_ids.insert(comment.id(), m_nodes.size() - 1);
+        return m_nodes.size() - 1;
+    }
+
+    // turns the replies of node into nodes, levels deep
+    void materialize(int node, int levels)
+    {
+        if (levels <= 0) {
+            return;
+        }
+        const Comment::List children = m_nodes.at(node).comment.children();
+        const int depth = m_nodes.at(node).depth + 1;
+        QVector<int> childNodes;
+        childNodes.reserve(children.size());
+        for (int i = 0; i < children.size(); ++i) {
+            childNodes.append(addNode(children.at(i), node, i, depth));
+        }
+        m_nodes[node].children = childNodes;
+        m_nodes[node].expanded = true;
+        for (int childNode : qAsConst(childNodes)) {
+            materialize(childNode, levels - 1);
+        }
+    }
+
+    int m_levels;
+    QVector<Node> m_nodes;
+    QVector<int> m_topLevel;
+    QHash<QString, int> m_ids;
+};
+
+}
+
+#endif
@@ -0,0 +1,213 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_CONTENTSEARCHINDEX_H
+#define ATTICA_CONTENTSEARCHINDEX_H
+
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+
+#include "content.h"
+
+namespace Attica
+{
+
+/**
+ * An in-memory inverted index over Content for answering searches locally.
+ *
+ * name(), tags(), author(), summary() and description() are split into
+ * case folded words. Every word of a query is matched as a prefix, so
+ * partially typed words already find results; an item has to match all
+ * words of the query. Matches in the name weigh most, matches in the
+ * description least, and rating() and downloads() lift popular items.
+ *
+ * Fill the index from a ContentMirror or from search results and go to the
+ * server only when the index has no answer.
+ */
+class ContentSearchIndex
+{
+public:
+    void add(const Content &content)
+    {
+        remove(content.id());
+        QHash<QString, qreal> weights;
+        addField(weights, content.name(), 4.0);
+        addField(weights, content.tags().join(QLatin1Char(' ')), 3.0);
+        addField(weights, content.author(), 2.0);
+        addField(weights, content.summary(), 1.5);
+        addField(weights, content.description(), 1.0);
+
+        for (QHash<QString, qreal>::const_iterator it = weights.constBegin(); it != weights.constEnd(); ++it) {
+            m_postings[it.key()].insert(content.id(), it.value());
+        }
+        m_documents.insert(content.id(), Document(content, weights.keys()));
+    }
+
+    template <class Container>
+    void addAll(const Container &contents)
+    {
+        for (const Content &content : contents) {
+            add(content);
+        }
+    }
+
+    void remove(const QString &id)
+    {
+        QHash<QString, Document>::iterator document = m_documents.find(id);
+        if (document == m_documents.end()) {
+            return;
+        }
+        for (const QString &word : qAsConst(document->words)) {
+            QMap<QString, QHash<QString, qreal> >::iterator posting = m_postings.find(word);
+            if (posting != m_postings.end()) {
+                posting->remove(id);
+                if (posting->isEmpty()) {
+                    m_postings.erase(posting);
+                }
+            }
+        }
+        m_documents.erase(document);
+    }
+
+    void clear()
+    {
+        m_postings.clear();
+        m_documents.clear();
+    }
+
+    int count() const { return m_documents.size(); }
+
+    /**
+     * The items matching @p query, best match first, at most @p limit of them.
+     * A negative @p limit returns all matches. An empty query matches nothing.
+     */
+    Content::List search(const QString &query, int limit = 50) const
+    {
+        const QStringList words = tokenize(query);
+        if (words.isEmpty()) {
+            return Content::List();
+        }
+
+        QHash<QString, qreal> scores;
+        for (int i = 0; i < words.size(); ++i) {
+            const QHash<QString, qreal> matches = match(words.at(i));
+            if (i == 0) {
+                scores = matches;
+                continue;
+            }
+            for (QHash<QString, qreal>::iterator it = scores.begin(); it != scores.end();) {
+                const QHash<QString, qreal>::const_iterator found = matches.constFind(it.key());
+                if (found == matches.constEnd()) {
+                    it = scores.erase(it);
+                } else {
+                    it.value() += found.value();
+                    ++it;
+                }
+            }
+        }
+
+        QVector<QPair<qreal, QString> > ranked;
+        ranked.reserve(scores.size());
+        for (QHash<QString, qreal>::const_iterator it = scores.constBegin(); it != scores.constEnd(); ++it) {
+            const Content content = m_documents.value(it.key()).content;
+            const qreal popularity = (1.0 + content.rating() / 100.0) * (1.0 + std::log1p(qMax(0, content.downloads())) / 10.0);
+            ranked.append(qMakePair(it.value() * popularity, it.key()));
+        }
+        const int count = limit < 0 ? ranked.size() : qMin(limit, ranked.size());
+        std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+                          [](const QPair<qreal, QString> &a, const QPair<qreal, QString> &b) { return a.first > b.first; });
+
+        Content::List result;
+        result.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            result.append(m_documents.value(ranked.at(i).second).content);
+        }
+        return result;
+    }
+
+    /// Splits @p text into the case folded words the index is built from
+    static QStringList tokenize(const QString &text)
+    {
+        QStringList words;
+        QString word;
+        for (const QChar c : text) {
+            if (c.isLetterOrNumber()) {
+                word += c.toCaseFolded();
+            } else if (!word.isEmpty()) {
+                words.append(word);
+                word.clear();
+            }
+        }
+        if (!word.isEmpty()) {
+            words.append(word);
+        }
+        return words;
+    }
+
+private:
+    struct Document {
+        Document() {}
+        Document(const Content &content, const QStringList &words)
+            : content(content), words(words)
+        {
+        }
+        Content content;
+        QStringList words;
+    };
+
+    static void addField(QHash<QString, qreal> &weights, const QString &text, qreal weight)
+    {
+        const QStringList words = tokenize(text);
+        for (const QString &word : words) {
+            weights[word] += weight;
+        }
+    }
+
+    // the best weight per document among all words starting with prefix; exact matches count double
+    QHash<QString, qreal> match(const QString &prefix) const
+    {
+        QHash<QString, qreal> result;
+        for (QMap<QString, QHash<QString, qreal> >::const_iterator posting = m_postings.lowerBound(prefix);
+             posting != m_postings.constEnd() && posting.key().startsWith(prefix); ++posting) {
+            const qreal factor = posting.key().size() == prefix.size() ? 2.0 : 1.0;
+            for (QHash<QString, qreal>::const_iterator it = posting->constBegin(); it != posting->constEnd(); ++it) {
+                qreal &score = result[it.key()];
+                score = qMax(score, it.value() * factor);
+            }
+        }
+        return result;
+    }
+
+    QMap<QString, QHash<QString, qreal> > m_postings;
+    QHash<QString, Document> m_documents;
+};
+
+}
+
+#endif
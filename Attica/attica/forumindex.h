@@ -0,0 +1,292 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_FORUMINDEX_H
+#define ATTICA_FORUMINDEX_H
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+
+#include "forum.h"
+#include "provider.h"
+
+namespace Attica
+{
+
+/**
+ * The forum hierarchy of a Provider, stored flat with parent links.
+ *
+ * Navigation (parentId(), childIds(), childCount()) and the aggregated
+ * topic count of a whole subtree (subtreeTopics()) are hash lookups, so
+ * rendering the tree never walks it.
+ *
+ * load() pages through Provider::requestForums() and builds the index.
+ * refresh() fetches again only until the given forum shows up and replaces
+ * just its subtree, updating the aggregates of its ancestors. A forum that
+ * is no longer listed is removed and reported through forumRemoved().
+ * Each walk through the pages keeps its own state, so a refresh() may run
+ * while load() does; calls for a walk that is already running are ignored.
+ */
+class ForumIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ForumIndex(const Provider &provider, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_loading(false)
+    {
+    }
+
+    /// Fetches the whole hierarchy, emits loaded() when done
+    void load(uint pageSize = 100)
+    {
+        if (m_loading) {
+            return;
+        }
+        m_loading = true;
+        QSharedPointer<Walk> walk(new Walk(QString(), pageSize));
+        requestPage(walk);
+    }
+
+    bool isLoading() const { return m_loading; }
+
+    /**
+     * Fetches the subtree of @p forumId again. Emits subtreeChanged() if it still exists,
+     * otherwise forumRemoved() after taking it out of the index.
+     */
+    void refresh(const QString &forumId, uint pageSize = 100)
+    {
+        if (forumId.isEmpty() || m_refreshing.contains(forumId)) {
+            return;
+        }
+        m_refreshing.insert(forumId);
+        QSharedPointer<Walk> walk(new Walk(forumId, pageSize));
+        requestPage(walk);
+    }
+
+    /// Replaces the whole index with @p forums
+    void setForums(const Forum::List &forums)
+    {
+        m_nodes.clear();
+        m_topLevel.clear();
+        for (const Forum &forum : forums) {
+            m_topLevel.append(forum.id());
+            insert(forum, QString());
+        }
+    }
+
+    /// Replaces the subtree of @p forum, keeping its position in the hierarchy
+    void updateSubtree(const Forum &forum)
+    {
+        QHash<QString, Node>::const_iterator old = m_nodes.constFind(forum.id());
+        if (old == m_nodes.constEnd()) {
+            return;
+        }
+        const QString parent = old->parent;
+        const int oldTopics = old->subtreeTopics;
+        remove(forum.id());
+        const int newTopics = insert(forum, parent);
+        for (QString ancestor = parent; !ancestor.isEmpty(); ancestor = m_nodes.value(ancestor).parent) {
+            m_nodes[ancestor].subtreeTopics += newTopics - oldTopics;
+        }
+    }
+
+    int count() const { return m_nodes.size(); }
+    bool contains(const QString &id) const { return m_nodes.contains(id); }
+    QStringList topLevelIds() const { return m_topLevel; }
+
+    Forum forum(const QString &id) const { return m_nodes.value(id).forum; }
+
+    /// The id of the parent forum, empty for top level forums
+    QString parentId(const QString &id) const { return m_nodes.value(id).parent; }
+
+    QStringList childIds(const QString &id) const { return m_nodes.value(id).children; }
+
+    int childCount(const QString &id) const { return m_nodes.value(id).children.size(); }
+
+    /// The topics in @p id itself
+    int topics(const QString &id) const { return m_nodes.value(id).forum.topics(); }
+
+    /// The topics in @p id and all forums below it
+    int subtreeTopics(const QString &id) const { return m_nodes.value(id).subtreeTopics; }
+
+Q_SIGNALS:
+    void loaded();
+    void subtreeChanged(const QString &id);
+    /// refresh() did not find @p id on the server any more
+    void forumRemoved(const QString &id);
+    void loadFailed(const Attica::Metadata &metadata);
+    void refreshFailed(const QString &id, const Attica::Metadata &metadata);
+
+private:
+    // the state of one load() or refresh() paging through requestForums()
+    struct Walk {
+        Walk(const QString &target, uint pageSize) : target(target), pageSize(pageSize), page(0), received(0) {}
+        QString target;
+        uint pageSize;
+        uint page;
+        int received;
+        Forum::List forums;
+    };
+
+    struct Node {
+        Node() : subtreeTopics(0) {}
+        Forum forum;
+        QString parent;
+        QStringList children;
+        int subtreeTopics;
+    };
+
+    // returns the topics in the inserted subtree
+    int insert(const Forum &forum, const QString &parent)
+    {
+        Node &node = m_nodes[forum.id()];
+        node.forum = forum;
+        node.parent = parent;
+
+        int topics = forum.topics();
+        QStringList children;
+        const Forum::List childForums = forum.children();
+        for (const Forum &child : childForums) {
+            children.append(child.id());
+            topics += insert(child, forum.id());
+        }
+        // insert() above may have rehashed m_nodes, so look the node up again
+        Node &inserted = m_nodes[forum.id()];
+        inserted.children = children;
+        inserted.subtreeTopics = topics;
+        return topics;
+    }
+
+    // takes @p id and everything below it out of the index, including the aggregates of its ancestors
+    void removeSubtree(const QString &id)
+    {
+        QHash<QString, Node>::const_iterator node = m_nodes.constFind(id);
+        if (node == m_nodes.constEnd()) {
+            return;
+        }
+        const QString parent = node->parent;
+        const int topics = node->subtreeTopics;
+        remove(id);
+        if (parent.isEmpty()) {
+            m_topLevel.removeAll(id);
+            return;
+        }
+        m_nodes[parent].children.removeAll(id);
+        for (QString ancestor = parent; !ancestor.isEmpty(); ancestor = m_nodes.value(ancestor).parent) {
+            m_nodes[ancestor].subtreeTopics -= topics;
+        }
+    }
+
+    void remove(const QString &id)
+    {
+        const Node node = m_nodes.take(id);
+        for (const QString &child : node.children) {
+            remove(child);
+        }
+    }
+
+    static bool findIn(const Forum::List &forums, const QString &id, Forum *result)
+    {
+        for (const Forum &forum : forums) {
+            if (forum.id() == id) {
+                *result = forum;
+                return true;
+            }
+            if (findIn(forum.children(), id, result)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void requestPage(const QSharedPointer<Walk> &walk)
+    {
+        ListJob<Forum> *job = m_provider.requestForums(walk->page, walk->pageSize);
+        connect(job, &BaseJob::finished, this, [this, walk](BaseJob *baseJob) {
+            pageFinished(walk, baseJob);
+        });
+        job->start();
+    }
+
+    void pageFinished(const QSharedPointer<Walk> &walk, BaseJob *baseJob)
+    {
+        Metadata metadata = baseJob->metadata();
+        if (metadata.error() != Metadata::NoError) {
+            if (walk->target.isEmpty()) {
+                m_loading = false;
+                emit loadFailed(metadata);
+            } else {
+                m_refreshing.remove(walk->target);
+                emit refreshFailed(walk->target, metadata);
+            }
+            return;
+        }
+        const Forum::List forums = static_cast<ListJob<Forum> *>(baseJob)->itemList();
+        walk->received += forums.size();
+        const int total = metadata.totalItems();
+        const bool lastPage = forums.isEmpty() || (total > 0 ? walk->received >= total : uint(forums.size()) < walk->pageSize);
+
+        if (!walk->target.isEmpty()) {
+            Forum forum;
+            if (findIn(forums, walk->target, &forum)) {
+                m_refreshing.remove(walk->target);
+                updateSubtree(forum);
+                emit subtreeChanged(walk->target);
+            } else if (lastPage) {
+                m_refreshing.remove(walk->target);
+                removeSubtree(walk->target);
+                emit forumRemoved(walk->target);
+            } else {
+                ++walk->page;
+                requestPage(walk);
+            }
+            return;
+        }
+
+        walk->forums += forums;
+        if (lastPage) {
+            m_loading = false;
+            setForums(walk->forums);
+            emit loaded();
+        } else {
+            ++walk->page;
+            requestPage(walk);
+        }
+    }
+
+    Provider m_provider;
+    QHash<QString, Node> m_nodes;
+    QStringList m_topLevel;
+    QSet<QString> m_refreshing;
+    bool m_loading;
+};
+
+}
+
+#endif
@@ -0,0 +1,311 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_JOBSTATS_H
+#define ATTICA_JOBSTATS_H
+
+#include <QHash>
+#include <QNetworkReply>
+#include <QMetaType>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+
+#include <chrono>
+
+#include "atticabasejob.h"
+#include "itemjob.h"
+#include "jobtracer.h"
+#include "listjob.h"
+#include "metadata.h"
+#include "providermanager.h"
+
+namespace Attica
+{
+
+/**
+ * Timing figures for a single job, recorded by a JobStatsRecorder.
+ *
+ * All timestamps are monotonic microseconds taken with now(); -1 means the
+ * phase has not been reached. The library performs the request, the download
+ * and parse() back to back, so they are reported together as transferTime().
+ * That includes the time the job waits for BaseJob to run it and for
+ * QNetworkAccessManager to free a connection to the host; the library does
+ * not report these phases, so they cannot be measured separately.
+ */
+class JobStats
+{
+public:
+    JobStats()
+        : m_createdAt(-1)
+        , m_startedAt(-1)
+        , m_finishedAt(-1)
+        , m_itemCount(0)
+        , m_statusCode(0)
+        , m_error(Metadata::NoError)
+    {
+    }
+
+    /// The current time on the monotonic clock used for all timestamps
+    static qint64 now()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// The base url of the provider the job talks to
+    QUrl provider() const { return m_provider; }
+    void setProvider(const QUrl &provider) { m_provider = provider; }
+
+    /// A label for the called part of the API, for example "content/data"
+    QString endpoint() const { return m_endpoint; }
+    void setEndpoint(const QString &endpoint) { m_endpoint = endpoint; }
+
+    qint64 createdAt() const { return m_createdAt; }
+    void setCreatedAt(qint64 time) { m_createdAt = time; }
+
+    qint64 startedAt() const { return m_startedAt; }
+    void setStartedAt(qint64 time) { m_startedAt = time; }
+
+    qint64 finishedAt() const { return m_finishedAt; }
+    void setFinishedAt(qint64 time) { m_finishedAt = time; }
+
+    bool isFinished() const { return m_finishedAt >= 0; }
+
+    /**
+     * Time between creating the job and calling start() on it, or -1 if unknown.
+     * This is the delay caused by the caller, not network queueing; see transferTime().
+     */
+    qint64 startDelay() const
+    {
+        return (m_createdAt < 0 || m_startedAt < 0) ? -1 : m_startedAt - m_createdAt;
+    }
+
+    /// Time between starting the job and finished(), including any queueing in the library, or -1 if unknown
+    qint64 transferTime() const
+    {
+        return (m_startedAt < 0 || m_finishedAt < 0) ? -1 : m_finishedAt - m_startedAt;
+    }
+
+    /// Time between creating the job and finished(), or -1 if unknown
+    qint64 totalTime() const
+    {
+        return (m_createdAt < 0 || m_finishedAt < 0) ? -1 : m_finishedAt - m_createdAt;
+    }
+
+    /// The number of items the job parsed (list size for list jobs, 1 for item jobs)
+    int itemCount() const { return m_itemCount; }
+    void setItemCount(int count) { m_itemCount = count; }
+
+    Metadata::Error error() const { return m_error; }
+    void setError(Metadata::Error error) { m_error = error; }
+
+    /// @see Metadata::statusCode()
+    int statusCode() const { return m_statusCode; }
+    void setStatusCode(int code) { m_statusCode = code; }
+
+private:
+    QUrl m_provider;
+    QString m_endpoint;
+    qint64 m_createdAt;
+    qint64 m_startedAt;
+    qint64 m_finishedAt;
+    int m_itemCount;
+    int m_statusCode;
+    Metadata::Error m_error;
+};
+
+/**
+ * Records JobStats for jobs returned by a Provider.
+ *
+ * Pass a job to track() right after the Provider created it and start it
+ * through start(), so that the delay until the caller started it can be
+ * told apart from the time the library needed:
+ * \code
+ * ListJob<Content> *job = recorder->track(provider.searchContents(categories), provider.baseUrl(), QStringLiteral("content/data"));
+ * recorder->start(job);
+ * \endcode
+ * jobFinished() is emitted with the complete figures once the job is done.
+ *
+ * With a JobTracer installed, the recorder also reports when each job was
+ * created, started, finished and deleted, and on which thread.
+ *
+ * Jobs may live in other threads than the recorder: the job's events are
+ * handled directly on the job's thread, so the tracer sees the thread the
+ * event happened on, and the recorded figures are guarded by a mutex.
+ * jobFinished() is delivered to receivers in other threads queued, as usual.
+ *
+ * Like the other helper classes in this directory, the recorder is
+ * implemented in this header only and its moc output is not part of
+ * libKF5Attica. qmake projects get it through attica.pri; CMake projects
+ * have to add the header to a target with AUTOMOC enabled or run
+ * qt5_wrap_cpp() on it.
+ */
+class JobStatsRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit JobStatsRecorder(QObject *parent = nullptr)
+        : QObject(parent)
+        , m_tracer(nullptr)
+    {
+    }
+
+    /**
+     * Reports the lifecycle of all jobs tracked from now on to @p tracer.
+     * The recorder does not take ownership; pass nullptr to stop tracing.
+     */
+    void setTracer(JobTracer *tracer)
+    {
+        m_tracer = tracer;
+    }
+
+    /// Reports providers being added or failing to load in @p manager to the tracer
+    void traceProviderManager(ProviderManager *manager)
+    {
+        connect(manager, &ProviderManager::providerAdded, this, [this](const Attica::Provider &provider) {
+            trace(JobTracer::ProviderAdded, 0, provider.baseUrl().toString());
+        });
+        connect(manager, &ProviderManager::defaultProvidersLoaded, this, [this]() {
+            trace(JobTracer::DefaultProvidersLoaded, 0, QString());
+        });
+        connect(manager, &ProviderManager::failedToLoad, this, [this](const QUrl &provider, QNetworkReply::NetworkError) {
+            trace(JobTracer::ProviderFailedToLoad, 0, provider.toString());
+        });
+    }
+
+    BaseJob *track(BaseJob *job, const QUrl &provider, const QString &endpoint)
+    {
+        watch(job, provider, endpoint, &countNothing);
+        return job;
+    }
+
+    template <class T>
+    ItemJob<T> *track(ItemJob<T> *job, const QUrl &provider, const QString &endpoint)
+    {
+        watch(job, provider, endpoint, &countOne);
+        return job;
+    }
+
+    template <class T>
+    ListJob<T> *track(ListJob<T> *job, const QUrl &provider, const QString &endpoint)
+    {
+        watch(job, provider, endpoint, &countList<T>);
+        return job;
+    }
+
+    /// Records the start time of a tracked @p job and starts it
+    void start(BaseJob *job)
+    {
+        QMutexLocker locker(&m_mutex);
+        QHash<BaseJob *, JobStats>::iterator it = m_jobs.find(job);
+        if (it != m_jobs.end()) {
+            it->setStartedAt(JobStats::now());
+            trace(JobTracer::JobStarted, quintptr(job), it->endpoint(), it->startedAt());
+        }
+        locker.unlock();
+        job->start();
+    }
+
+    /// The figures recorded so far for a tracked @p job that has not been deleted yet
+    JobStats stats(BaseJob *job) const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_jobs.value(job);
+    }
+
+Q_SIGNALS:
+    void jobFinished(const Attica::JobStats &stats);
+
+private:
+    typedef int (*ItemCounter)(BaseJob *);
+
+    static int countNothing(BaseJob *) { return 0; }
+    static int countOne(BaseJob *) { return 1; }
+    template <class T>
+    static int countList(BaseJob *job) { return static_cast<ListJob<T> *>(job)->itemList().size(); }
+
+    void watch(BaseJob *job, const QUrl &provider, const QString &endpoint, ItemCounter counter)
+    {
+        JobStats stats;
+        stats.setProvider(provider);
+        stats.setEndpoint(endpoint);
+        stats.setCreatedAt(JobStats::now());
+        {
+            QMutexLocker locker(&m_mutex);
+            m_jobs.insert(job, stats);
+        }
+        trace(JobTracer::JobCreated, quintptr(job), endpoint, stats.createdAt());
+
+        // direct, so the tracer sees the job's thread and not the recorder's
+        connect(job, &BaseJob::finished, this, [this, counter](BaseJob *finishedJob) {
+            finish(finishedJob, counter);
+        }, Qt::DirectConnection);
+        connect(job, &QObject::destroyed, this, [this, job]() {
+            QMutexLocker locker(&m_mutex);
+            const QString endpoint = m_jobs.take(job).endpoint();
+            locker.unlock();
+            trace(JobTracer::JobDeleted, quintptr(job), endpoint);
+        }, Qt::DirectConnection);
+    }
+
+    void finish(BaseJob *job, ItemCounter counter)
+    {
+        const qint64 finishedAt = JobStats::now();
+        const Metadata metadata = job->metadata();
+        const int itemCount = metadata.error() == Metadata::NoError ? counter(job) : 0;
+
+        QMutexLocker locker(&m_mutex);
+        QHash<BaseJob *, JobStats>::iterator it = m_jobs.find(job);
+        if (it == m_jobs.end()) {
+            return;
+        }
+        it->setFinishedAt(finishedAt);
+        it->setError(metadata.error());
+        it->setStatusCode(metadata.statusCode());
+        it->setItemCount(itemCount);
+        const JobStats stats = *it;
+        locker.unlock();
+
+        trace(JobTracer::JobFinished, quintptr(job), stats.endpoint(), stats.finishedAt());
+        emit jobFinished(stats);
+    }
+
+    void trace(JobTracer::Event event, quintptr id, const QString &name, qint64 timestamp = JobStats::now())
+    {
+        if (m_tracer) {
+            m_tracer->traceEvent(event, id, name, timestamp, JobTracer::currentThread());
+        }
+    }
+
+    mutable QMutex m_mutex;
+    QHash<BaseJob *, JobStats> m_jobs;
+    JobTracer *m_tracer;
+};
+
+}
+
+Q_DECLARE_METATYPE(Attica::JobStats)
+
+#endif
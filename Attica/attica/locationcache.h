@@ -0,0 +1,683 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_LOCATIONCACHE_H
+#define ATTICA_LOCATIONCACHE_H
+
+#include <QCache>
+#include <QDate>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QUrl>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+#include "event.h"
+#include "listjob.h"
+#include "metadata.h"
+#include "person.h"
+#include "postjob.h"
+#include "provider.h"
+#include "sharedinstances.h"
+
+namespace Attica
+{
+
+/**
+ * A spatial cache for the location based searches of a map view.
+ *
+ * The map is divided into geohash tiles. searchPersons() picks a tile size
+ * matching the search radius and answers from the tiles it already has;
+ * only the missing or outdated tiles are fetched, each with one
+ * Provider::requestPersonSearchByLocation() around its center. The result
+ * is filtered exactly by Person::latitude() and Person::longitude(), so
+ * panning over an area seen before costs no request at all.
+ *
+ * Provider::requestEvent() can only filter by country and date, so
+ * searchEvents() fetches the events of a country once, buckets them by
+ * tile and filters them by Event::latitude() and Event::longitude().
+ *
+ * All distances are in kilometers. The results of a search are delivered
+ * through personsFound() or eventsFound() with the id returned by the
+ * search, even when they come from the cache.
+ *
+ * A tile or country is paged through until the server's total is reached,
+ * or until an empty page if the server sends no total. Tiles stop after
+ * 1000 persons and countries after 2000 events; results built from such a
+ * cut off listing are reported as truncated.
+ */
+class LocationCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// The cache shared by all copies of @p provider, see SharedInstances
+    static LocationCache *forProvider(const Provider &provider)
+    {
+        return SharedInstances<LocationCache>::instance(provider.baseUrl(), [&](QObject *parent) {
+            return new LocationCache(provider, parent);
+        });
+    }
+
+    explicit LocationCache(const Provider &provider, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_tiles(1024)
+        , m_maxAge(10 * 60)
+        , m_nextQueryId(0)
+        , m_answerScheduled(false)
+    {
+    }
+
+    /// Seconds after which a tile or the events of a country are fetched again, 10 minutes by default
+    qint64 maxAge() const { return m_maxAge; }
+    void setMaxAge(qint64 seconds) { m_maxAge = seconds; }
+
+    /// The number of person tiles kept, 1024 by default
+    int maxTiles() const { return m_tiles.maxCost(); }
+    void setMaxTiles(int count) { m_tiles.setMaxCost(count); }
+
+    /**
+     * Searches for persons within @p distance of a position.
+     * Fetches the tiles that are missing and emits personsFound() when all are there.
+     * @return the id passed to personsFound() or personSearchFailed()
+     */
+    int searchPersons(qreal latitude, qreal longitude, qreal distance)
+    {
+        const int id = ++m_nextQueryId;
+        PersonQuery query;
+        query.latitude = latitude;
+        query.longitude = longitude;
+        query.distance = qMax(distance, qreal(MinimumDistance));
+        query.tiles = tilesCovering(latitude, longitude, query.distance, precisionFor(latitude, query.distance));
+        for (const TileId &tile : qAsConst(query.tiles)) {
+            const Tile *cached = m_tiles.object(tile.key);
+            if (!cached || cached->fetched.secsTo(QDateTime::currentDateTimeUtc()) > m_maxAge) {
+                requestTile(tile);
+            }
+        }
+        m_personQueries.insert(id, query);
+        scheduleAnswers();
+        return id;
+    }
+
+    /// The persons within @p distance of a position that are in the cache right now
+    Person::List cachedPersons(qreal latitude, qreal longitude, qreal distance) const
+    {
+        distance = qMax(distance, qreal(MinimumDistance));
+        const QList<TileId> tiles = tilesCovering(latitude, longitude, distance, precisionFor(latitude, distance));
+        QList<const Tile *> found;
+        for (const TileId &tile : tiles) {
+            if (const Tile *cached = m_tiles.object(tile.key)) {
+                found.append(cached);
+            }
+        }
+        return personsWithin(found, latitude, longitude, distance);
+    }
+
+    /**
+     * Searches for events in @p country starting at @p startAt or later that take place within
+     * @p distance of a position.
+     * @return the id passed to eventsFound() or eventSearchFailed()
+     */
+    int searchEvents(const QString &country, const QDate &startAt, qreal latitude, qreal longitude, qreal distance,
+                     const QString &search = QString())
+    {
+        const int id = ++m_nextQueryId;
+        EventQuery query;
+        query.area = areaKey(country, search, startAt);
+        query.latitude = latitude;
+        query.longitude = longitude;
+        query.distance = qMax(distance, qreal(MinimumDistance));
+
+        QHash<QString, EventArea>::const_iterator area = m_eventAreas.constFind(query.area);
+        if (area == m_eventAreas.constEnd() || area->fetched.secsTo(QDateTime::currentDateTimeUtc()) > m_maxAge) {
+            requestEvents(query.area, country, search, startAt);
+        }
+        m_eventQueries.insert(id, query);
+        scheduleAnswers();
+        return id;
+    }
+
+    /**
+     * Posts the own location like Provider::postLocation() and drops the cached tiles
+     * around it once the server accepted it. The returned job still needs to be started.
+     */
+    PostJob *postLocation(qreal latitude, qreal longitude, const QString &city = QString(), const QString &country = QString())
+    {
+        PostJob *job = m_provider.postLocation(latitude, longitude, city, country);
+        connect(job, &BaseJob::finished, this, [this, latitude, longitude](BaseJob *baseJob) {
+            if (baseJob->metadata().error() == Metadata::NoError) {
+                invalidate(latitude, longitude);
+            }
+        });
+        return job;
+    }
+
+    /// Drops the cached person tiles of all sizes that contain a position
+    void invalidate(qreal latitude, qreal longitude)
+    {
+        for (int precision = 1; precision <= MaxPrecision; ++precision) {
+            m_tiles.remove(tileAt(latitude, longitude, precision).key);
+        }
+    }
+
+    void clear()
+    {
+        m_tiles.clear();
+        m_eventAreas.clear();
+    }
+
+    /// Great circle distance in kilometers
+    static qreal distance(qreal latitude1, qreal longitude1, qreal latitude2, qreal longitude2)
+    {
+        const qreal dLatitude = qDegreesToRadians(latitude2 - latitude1);
+        const qreal dLongitude = qDegreesToRadians(longitude2 - longitude1);
+        const qreal a = std::sin(dLatitude / 2) * std::sin(dLatitude / 2)
+                        + std::cos(qDegreesToRadians(latitude1)) * std::cos(qDegreesToRadians(latitude2))
+                          * std::sin(dLongitude / 2) * std::sin(dLongitude / 2);
+        return 2 * EarthRadius * std::asin(qMin(qreal(1), std::sqrt(a)));
+    }
+
+    /// The geohash of a position with @p precision characters
+    static QString geohash(qreal latitude, qreal longitude, int precision)
+    {
+        return tileAt(latitude, longitude, qBound(1, precision, int(MaxPrecision))).key;
+    }
+
+Q_SIGNALS:
+    /// @p truncated is set when a tile had more persons than are fetched for one tile
+    void personsFound(int id, const Attica::Person::List &persons, bool truncated);
+    void personSearchFailed(int id, const Attica::Metadata &metadata);
+    /// @p truncated is set when the country had more events than are fetched for one country
+    void eventsFound(int id, const Attica::Event::List &events, bool truncated);
+    void eventSearchFailed(int id, const Attica::Metadata &metadata);
+
+private:
+    enum {
+        MaxPrecision = 8,
+        // tiles fetched for one search at most; larger searches use larger tiles
+        MaxTilesPerSearch = 16,
+        // events are bucketed into tiles of about 20 by 40 km
+        EventPrecision = 4,
+        MinimumDistance = 1,
+        PageSize = 100,
+        MaxPersonPages = 10,
+        MaxEventPages = 20
+    };
+
+    static constexpr qreal EarthRadius = 6371.0;
+    static constexpr qreal KmPerDegree = 111.32;
+
+    struct TileId {
+        QString key;
+        int precision;
+        int latitudeIndex;
+        int longitudeIndex;
+    };
+
+    struct Tile {
+        Person::List persons;
+        QDateTime fetched;
+        // the server has more persons than MaxPersonPages pages
+        bool truncated;
+    };
+
+    struct TileRequest {
+        TileId tile;
+        Person::List persons;
+        int page;
+        int received;
+    };
+
+    struct PersonQuery {
+        qreal latitude;
+        qreal longitude;
+        qreal distance;
+        QList<TileId> tiles;
+    };
+
+    struct EventArea {
+        QHash<QString, Event::List> tiles;
+        int count;
+        QDateTime fetched;
+        // the server has more events than MaxEventPages pages
+        bool truncated;
+    };
+
+    struct EventRequest {
+        QString country;
+        QString search;
+        QDate startAt;
+        Event::List events;
+        int page;
+        int received;
+    };
+
+    struct EventQuery {
+        QString area;
+        qreal latitude;
+        qreal longitude;
+        qreal distance;
+    };
+
+    // a geohash of n characters has ceil(5n / 2) longitude bits and floor(5n / 2) latitude bits
+    static int latitudeBits(int precision) { return precision * 5 / 2; }
+    static int longitudeBits(int precision) { return precision * 5 - latitudeBits(precision); }
+    static qreal tileHeight(int precision) { return 180.0 / (1 << latitudeBits(precision)); }
+    static qreal tileWidth(int precision) { return 360.0 / (1 << longitudeBits(precision)); }
+
+    static TileId tile(int latitudeIndex, int longitudeIndex, int precision)
+    {
+        static const char base32[] = "0123456789bcdefghjkmnpqrstuvwxyz";
+        const int rows = 1 << latitudeBits(precision);
+        const int columns = 1 << longitudeBits(precision);
+
+        TileId id;
+        id.precision = precision;
+        id.latitudeIndex = qBound(0, latitudeIndex, rows - 1);
+        id.longitudeIndex = ((longitudeIndex % columns) + columns) % columns;
+
+        // bits alternate between longitude and latitude, starting with longitude
+        int latitudeShift = latitudeBits(precision);
+        int longitudeShift = longitudeBits(precision);
+        int value = 0;
+        id.key.reserve(precision);
+        for (int bit = 0; bit < precision * 5; ++bit) {
+            const int index = bit % 2 == 0 ? (id.longitudeIndex >> --longitudeShift) : (id.latitudeIndex >> --latitudeShift);
+            value = (value << 1) | (index & 1);
+            if (bit % 5 == 4) {
+                id.key += QLatin1Char(base32[value]);
+                value = 0;
+            }
+        }
+        return id;
+    }
+
+    static TileId tileAt(qreal latitude, qreal longitude, int precision)
+    {
+        return tile(int(std::floor((latitude + 90) / tileHeight(precision))),
+                    int(std::floor((longitude + 180) / tileWidth(precision))), precision);
+    }
+
+    // the longitude degrees covered by @p distance at @p latitude, 360 where that is everything
+    static qreal longitudeSpan(qreal latitude, qreal distance)
+    {
+        const qreal scale = std::cos(qDegreesToRadians(qBound(qreal(-90), latitude, qreal(90))));
+        return scale < 0.01 ? 360 : qMin(qreal(360), distance / (KmPerDegree * scale));
+    }
+
+    // the smallest tiles that are at least as large as the search radius and not too many
+    static int precisionFor(qreal latitude, qreal distance)
+    {
+        const qreal latitudeSpan = distance / KmPerDegree;
+        const qreal lonSpan = longitudeSpan(latitude, distance);
+        for (int precision = MaxPrecision; precision > 1; --precision) {
+            const int rows = int(std::ceil(2 * latitudeSpan / tileHeight(precision))) + 1;
+            const int columns = int(std::ceil(2 * lonSpan / tileWidth(precision))) + 1;
+            if (tileHeight(precision) * KmPerDegree >= distance && rows * columns <= MaxTilesPerSearch) {
+                return precision;
+            }
+        }
+        return 1;
+    }
+
+    static QList<TileId> tilesCovering(qreal latitude, qreal longitude, qreal distance, int precision)
+    {
+        const qreal latitudeSpan = distance / KmPerDegree;
+        const qreal lonSpan = longitudeSpan(latitude, distance);
+        const int columns = 1 << longitudeBits(precision);
+
+        const int firstRow = int(std::floor((qMax(qreal(-90), latitude - latitudeSpan) + 90) / tileHeight(precision)));
+        const int lastRow = int(std::floor((qMin(qreal(90), latitude + latitudeSpan) + 90) / tileHeight(precision)));
+        int firstColumn = int(std::floor((longitude - lonSpan + 180) / tileWidth(precision)));
+        int lastColumn = int(std::floor((longitude + lonSpan + 180) / tileWidth(precision)));
+        if (lastColumn - firstColumn + 1 >= columns) {
+            firstColumn = 0;
+            lastColumn = columns - 1;
+        }
+
+        QList<TileId> tiles;
+        QSet<QString> keys;
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                const TileId id = tile(row, column, precision);
+                if (!keys.contains(id.key)) {
+                    keys.insert(id.key);
+                    tiles.append(id);
+                }
+            }
+        }
+        return tiles;
+    }
+
+    static Person::List personsWithin(const QList<const Tile *> &tiles, qreal latitude, qreal longitude, qreal radius)
+    {
+        QList<QPair<qreal, Person> > found;
+        for (const Tile *tile : tiles) {
+            for (const Person &person : tile->persons) {
+                const qreal d = distance(latitude, longitude, person.latitude(), person.longitude());
+                if (d <= radius) {
+                    found.append(qMakePair(d, person));
+                }
+            }
+        }
+        std::stable_sort(found.begin(), found.end(), [](const QPair<qreal, Person> &a, const QPair<qreal, Person> &b) {
+            return a.first < b.first;
+        });
+        Person::List persons;
+        persons.reserve(found.size());
+        for (const QPair<qreal, Person> &entry : qAsConst(found)) {
+            persons.append(entry.second);
+        }
+        return persons;
+    }
+
+    static QString areaKey(const QString &country, const QString &search, const QDate &startAt)
+    {
+        return country + QLatin1Char('\n') + search + QLatin1Char('\n') + startAt.toString(Qt::ISODate);
+    }
+
+    void requestTile(const TileId &tile)
+    {
+        if (m_tileRequests.contains(tile.key)) {
+            return;
+        }
+        TileRequest request;
+        request.tile = tile;
+        request.page = 0;
+        request.received = 0;
+        m_tileRequests.insert(tile.key, request);
+        requestTilePage(tile.key);
+    }
+
+    void requestTilePage(const QString &key)
+    {
+        const TileRequest &request = m_tileRequests[key];
+        const int precision = request.tile.precision;
+        const qreal south = request.tile.latitudeIndex * tileHeight(precision) - 90;
+        const qreal west = request.tile.longitudeIndex * tileWidth(precision) - 180;
+        const qreal latitude = south + tileHeight(precision) / 2;
+        const qreal longitude = west + tileWidth(precision) / 2;
+        // the circle around the center that reaches the corners of the tile
+        const qreal radius = qMax(distance(latitude, longitude, south, west),
+                                  distance(latitude, longitude, south + tileHeight(precision), west));
+
+        ListJob<Person> *job = m_provider.requestPersonSearchByLocation(latitude, longitude, radius, request.page, PageSize);
+        connect(job, &BaseJob::finished, this, [this, key](BaseJob *baseJob) {
+            tilePageFetched(key, baseJob);
+        });
+        job->start();
+    }
+
+    // the server's total decides, an empty page only ends a listing without one
+    static bool isLastPage(int pageItems, int received, Metadata &metadata)
+    {
+        const int total = metadata.totalItems();
+        return pageItems == 0 || (total > 0 && received >= total);
+    }
+
+    void tilePageFetched(const QString &key, BaseJob *baseJob)
+    {
+        Metadata metadata = baseJob->metadata();
+        if (metadata.error() != Metadata::NoError) {
+            m_tileRequests.remove(key);
+            tileFailed(key, metadata);
+            return;
+        }
+
+        TileRequest &request = m_tileRequests[key];
+        const Person::List persons = static_cast<ListJob<Person> *>(baseJob)->itemList();
+        for (const Person &person : persons) {
+            // the search circle overlaps the neighbours, they fetch their own persons
+            if (tileAt(person.latitude(), person.longitude(), request.tile.precision).key == key) {
+                request.persons.append(person);
+            }
+        }
+        request.received += persons.size();
+        const bool complete = isLastPage(persons.size(), request.received, metadata);
+        if (!complete && ++request.page < MaxPersonPages) {
+            requestTilePage(key);
+            return;
+        }
+
+        Tile *tile = new Tile;
+        tile->persons = request.persons;
+        tile->fetched = QDateTime::currentDateTimeUtc();
+        tile->truncated = !complete;
+        m_tileRequests.remove(key);
+        m_tiles.insert(key, tile);
+        answerPersonQueries();
+    }
+
+    void tileFailed(const QString &key, const Metadata &metadata)
+    {
+        // searches go on with an outdated tile, but not without any
+        if (m_tiles.contains(key)) {
+            answerPersonQueries();
+            return;
+        }
+        QList<int> failed;
+        for (QHash<int, PersonQuery>::const_iterator it = m_personQueries.constBegin(); it != m_personQueries.constEnd(); ++it) {
+            for (const TileId &tile : it->tiles) {
+                if (tile.key == key) {
+                    failed.append(it.key());
+                    break;
+                }
+            }
+        }
+        for (int id : qAsConst(failed)) {
+            m_personQueries.remove(id);
+        }
+        for (int id : qAsConst(failed)) {
+            emit personSearchFailed(id, metadata);
+        }
+    }
+
+    void requestEvents(const QString &area, const QString &country, const QString &search, const QDate &startAt)
+    {
+        if (m_eventRequests.contains(area)) {
+            return;
+        }
+        EventRequest request;
+        request.country = country;
+        request.search = search;
+        request.startAt = startAt;
+        request.page = 0;
+        request.received = 0;
+        m_eventRequests.insert(area, request);
+        requestEventPage(area);
+    }
+
+    void requestEventPage(const QString &area)
+    {
+        const EventRequest &request = m_eventRequests[area];
+        ListJob<Event> *job = m_provider.requestEvent(request.country, request.search, request.startAt, Provider::Newest, request.page, PageSize);
+        connect(job, &BaseJob::finished, this, [this, area](BaseJob *baseJob) {
+            eventPageFetched(area, baseJob);
+        });
+        job->start();
+    }
+
+    void eventPageFetched(const QString &area, BaseJob *baseJob)
+    {
+        Metadata metadata = baseJob->metadata();
+        if (metadata.error() != Metadata::NoError) {
+            m_eventRequests.remove(area);
+            if (m_eventAreas.contains(area)) {
+                answerEventQueries();
+                return;
+            }
+            QList<int> failed;
+            for (QHash<int, EventQuery>::const_iterator it = m_eventQueries.constBegin(); it != m_eventQueries.constEnd(); ++it) {
+                if (it->area == area) {
+                    failed.append(it.key());
+                }
+            }
+            for (int id : qAsConst(failed)) {
+                m_eventQueries.remove(id);
+            }
+            for (int id : qAsConst(failed)) {
+                emit eventSearchFailed(id, metadata);
+            }
+            return;
+        }
+
+        EventRequest &request = m_eventRequests[area];
+        const Event::List events = static_cast<ListJob<Event> *>(baseJob)->itemList();
+        request.events.append(events);
+        request.received += events.size();
+        const bool complete = isLastPage(events.size(), request.received, metadata);
+        if (!complete && ++request.page < MaxEventPages) {
+            requestEventPage(area);
+            return;
+        }
+
+        EventArea bucketed;
+        bucketed.count = request.events.size();
+        bucketed.fetched = QDateTime::currentDateTimeUtc();
+        bucketed.truncated = !complete;
+        for (const Event &event : qAsConst(request.events)) {
+            bucketed.tiles[tileAt(event.latitude(), event.longitude(), EventPrecision).key].append(event);
+        }
+        m_eventRequests.remove(area);
+        m_eventAreas.insert(area, bucketed);
+        answerEventQueries();
+    }
+
+    // searches are answered from the event loop, also when everything is cached already
+    void scheduleAnswers()
+    {
+        if (m_answerScheduled) {
+            return;
+        }
+        m_answerScheduled = true;
+        QTimer::singleShot(0, this, [this]() {
+            m_answerScheduled = false;
+            answerPersonQueries();
+            answerEventQueries();
+        });
+    }
+
+    void answerPersonQueries()
+    {
+        QList<QPair<int, Person::List> > answers;
+        QSet<int> truncated;
+        QHash<int, PersonQuery>::iterator it = m_personQueries.begin();
+        while (it != m_personQueries.end()) {
+            QList<const Tile *> tiles;
+            bool complete = true;
+            bool cutOff = false;
+            for (const TileId &tile : qAsConst(it->tiles)) {
+                if (m_tileRequests.contains(tile.key)) {
+                    complete = false;
+                } else if (const Tile *cached = m_tiles.object(tile.key)) {
+                    tiles.append(cached);
+                    cutOff = cutOff || cached->truncated;
+                } else {
+                    // evicted while the other tiles were fetched
+                    complete = false;
+                    requestTile(tile);
+                }
+            }
+            if (!complete) {
+                ++it;
+                continue;
+            }
+            answers.append(qMakePair(it.key(), personsWithin(tiles, it->latitude, it->longitude, it->distance)));
+            if (cutOff) {
+                truncated.insert(it.key());
+            }
+            it = m_personQueries.erase(it);
+        }
+        for (const QPair<int, Person::List> &answer : qAsConst(answers)) {
+            emit personsFound(answer.first, answer.second, truncated.contains(answer.first));
+        }
+    }
+
+    void answerEventQueries()
+    {
+        QList<QPair<int, Event::List> > answers;
+        QSet<int> truncated;
+        QHash<int, EventQuery>::iterator it = m_eventQueries.begin();
+        while (it != m_eventQueries.end()) {
+            QHash<QString, EventArea>::const_iterator area = m_eventAreas.constFind(it->area);
+            if (m_eventRequests.contains(it->area) || area == m_eventAreas.constEnd()) {
+                ++it;
+                continue;
+            }
+
+            const QList<TileId> tiles = tilesCovering(it->latitude, it->longitude, it->distance, EventPrecision);
+            Event::List candidates;
+            if (tiles.size() < area->tiles.size()) {
+                for (const TileId &tile : tiles) {
+                    candidates.append(area->tiles.value(tile.key));
+                }
+            } else {
+                for (QHash<QString, Event::List>::const_iterator bucket = area->tiles.constBegin(); bucket != area->tiles.constEnd(); ++bucket) {
+                    candidates.append(*bucket);
+                }
+            }
+
+            Event::List events;
+            for (const Event &event : qAsConst(candidates)) {
+                if (distance(it->latitude, it->longitude, event.latitude(), event.longitude()) <= it->distance) {
+                    events.append(event);
+                }
+            }
+            std::stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b) {
+                return a.startDate() < b.startDate();
+            });
+            answers.append(qMakePair(it.key(), events));
+            if (area->truncated) {
+                truncated.insert(it.key());
+            }
+            it = m_eventQueries.erase(it);
+        }
+        for (const QPair<int, Event::List> &answer : qAsConst(answers)) {
+            emit eventsFound(answer.first, answer.second, truncated.contains(answer.first));
+        }
+    }
+
+    Provider m_provider;
+    QCache<QString, Tile> m_tiles;
+    QHash<QString, TileRequest> m_tileRequests;
+    QHash<int, PersonQuery> m_personQueries;
+    QHash<QString, EventArea> m_eventAreas;
+    QHash<QString, EventRequest> m_eventRequests;
+    QHash<int, EventQuery> m_eventQueries;
+    qint64 m_maxAge;
+    int m_nextQueryId;
+    bool m_answerScheduled;
+};
+
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_MESSAGESYNC_H
+#define ATTICA_MESSAGESYNC_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+#include <algorithm>
+
+#include "folder.h"
+#include "message.h"
+#include "provider.h"
+#include "unreadmessagepoller.h"
+
+namespace Attica
+{
+
+/**
+ * Keeps a local store of the messages in each Folder of a Provider.
+ *
+ * syncAll() polls the folders with an UnreadMessagePoller and lists only
+ * those whose Folder::messageCount() changed. Like the poller it misses
+ * read or unread changes made on another client and a deleted message
+ * replaced by a new one; syncAll(true) lists every folder.
+ *
+ * sync() lists a folder and only takes new messages (those with an unknown
+ * id) into the store, reporting them through messagesAdded(); known
+ * messages just get their status updated. Provider::requestMessages()
+ * only returns the first page of a folder, so stored messages missing from
+ * the listing are only dropped when it covered the whole folder.
+ *
+ * The store only keeps the headers; bodies are dropped from the listing
+ * and fetched with Provider::requestMessage() when requestBody() is called
+ * for a message that is being opened. The unread counts are those of the
+ * poller, adjusted locally when a message is read through requestBody()
+ * or setStatus().
+ */
+class MessageSync : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MessageSync(const Provider &provider, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_poller(provider)
+    {
+        connect(&m_poller, &UnreadMessagePoller::folderChanged, this, &MessageSync::sync);
+        connect(&m_poller, &UnreadMessagePoller::folderUnreadCountChanged, this, &MessageSync::unreadCountChanged);
+        connect(&m_poller, &UnreadMessagePoller::pollFailed, this, [this](const Metadata &metadata) {
+            emit syncFailed(QString(), metadata);
+        });
+    }
+
+    /// The poller deciding which folders syncAll() lists
+    UnreadMessagePoller *poller() { return &m_poller; }
+
+    /// Polls the folders and syncs those whose message count changed, or all of them if @p force is set
+    void syncAll(bool force = false)
+    {
+        m_poller.poll(force);
+    }
+
+    /// Brings the store of @p folder up to date
+    void sync(const Folder &folder)
+    {
+        Store &store = m_stores[folder.id()];
+        if (store.syncing) {
+            return;
+        }
+        store.syncing = true;
+
+        ListJob<Message> *job = m_provider.requestMessages(folder);
+        const QString folderId = folder.id();
+        const int messageCount = folder.messageCount();
+        connect(job, &BaseJob::finished, this, [this, folderId, messageCount](BaseJob *baseJob) {
+            m_stores[folderId].syncing = false;
+            Metadata metadata = baseJob->metadata();
+            if (metadata.error() != Metadata::NoError) {
+                emit syncFailed(folderId, metadata);
+                return;
+            }
+            const Message::List messages = static_cast<ListJob<Message> *>(baseJob)->itemList();
+            const int total = metadata.totalItems() > 0 ? metadata.totalItems() : messageCount;
+            merge(folderId, messages, messages.size() >= total);
+        });
+        job->start();
+    }
+
+    /// The stored messages of @p folderId without their bodies, newest first
+    Message::List messages(const QString &folderId) const
+    {
+        const QHash<QString, Message> headers = m_stores.value(folderId).headers;
+        Message::List result;
+        result.reserve(headers.size());
+        for (QHash<QString, Message>::const_iterator it = headers.constBegin(); it != headers.constEnd(); ++it) {
+            result.append(*it);
+        }
+        std::sort(result.begin(), result.end(), [](const Message &a, const Message &b) {
+            return a.sent() > b.sent();
+        });
+        return result;
+    }
+
+    int unreadCount(const QString &folderId) const { return m_poller.unreadCount(folderId); }
+    int unreadCount() const { return m_poller.unreadCount(); }
+
+    /// The newest sent() date of the messages stored for @p folderId
+    QDateTime newest(const QString &folderId) const
+    {
+        return m_stores.value(folderId).newest;
+    }
+
+    /**
+     * Emits bodyAvailable() with the complete message, fetching it from the
+     * server the first time. The message counts as read from then on.
+     */
+    void requestBody(const Folder &folder, const QString &id)
+    {
+        Store &store = m_stores[folder.id()];
+        QHash<QString, QString>::const_iterator body = store.bodies.constFind(id);
+        if (body != store.bodies.constEnd()) {
+            Message message = store.headers.value(id);
+            message.setBody(*body);
+            emit bodyAvailable(folder.id(), message);
+            return;
+        }
+
+        ItemJob<Message> *job = m_provider.requestMessage(folder, id);
+        const QString folderId = folder.id();
+        connect(job, &BaseJob::finished, this, [this, folderId, id](BaseJob *baseJob) {
+            if (baseJob->metadata().error() != Metadata::NoError) {
+                emit syncFailed(folderId, baseJob->metadata());
+                return;
+            }
+            Message message = static_cast<ItemJob<Message> *>(baseJob)->result();
+            Store &store = m_stores[folderId];
+            store.bodies.insert(id, message.body());
+            if (message.status() == Message::Unread) {
+                message.setStatus(Message::Read);
+            }
+            Message header(message);
+            header.setBody(QString());
+            updateHeader(folderId, store, header);
+            emit bodyAvailable(folderId, message);
+        });
+        job->start();
+    }
+
+    /// Changes the status of a stored message locally, e.g. after answering it
+    void setStatus(const QString &folderId, const QString &id, Message::Status status)
+    {
+        Store &store = m_stores[folderId];
+        QHash<QString, Message>::const_iterator it = store.headers.constFind(id);
+        if (it != store.headers.constEnd()) {
+            Message header(*it);
+            header.setStatus(status);
+            updateHeader(folderId, store, header);
+        }
+    }
+
+Q_SIGNALS:
+    /// New messages were stored for @p folderId; their bodies are not included
+    void messagesAdded(const QString &folderId, const Attica::Message::List &messages);
+    void unreadCountChanged(const QString &folderId, int count);
+    void bodyAvailable(const QString &folderId, const Attica::Message &message);
+    void syncFailed(const QString &folderId, const Attica::Metadata &metadata);
+
+private:
+    struct Store {
+        Store() : syncing(false) {}
+        QHash<QString, Message> headers;
+        QHash<QString, QString> bodies;
+        QDateTime newest;
+        bool syncing;
+    };
+
+    void merge(const QString &folderId, const Message::List &messages, bool complete)
+    {
+        Store &store = m_stores[folderId];
+        Message::List added;
+        QSet<QString> listed;
+        for (const Message &message : messages) {
+            listed.insert(message.id());
+            QHash<QString, Message>::iterator known = store.headers.find(message.id());
+            if (known != store.headers.end()) {
+                known->setStatus(message.status());
+                continue;
+            }
+            Message header(message);
+            header.setBody(QString());
+            store.headers.insert(header.id(), header);
+            if (!store.newest.isValid() || header.sent() > store.newest) {
+                store.newest = header.sent();
+            }
+            added.append(header);
+        }
+        // only a listing of the whole folder tells which messages were deleted on the server
+        if (complete) {
+            for (QHash<QString, Message>::iterator it = store.headers.begin(); it != store.headers.end();) {
+                if (listed.contains(it.key())) {
+                    ++it;
+                    continue;
+                }
+                store.bodies.remove(it.key());
+                it = store.headers.erase(it);
+            }
+        }
+        if (!added.isEmpty()) {
+            emit messagesAdded(folderId, added);
+        }
+    }
+
+    void updateHeader(const QString &folderId, Store &store, const Message &header)
+    {
+        const Message old = store.headers.value(header.id());
+        store.headers.insert(header.id(), header);
+        const int delta = (header.status() == Message::Unread) - (old.isValid() && old.status() == Message::Unread);
+        m_poller.adjustUnreadCount(folderId, delta);
+    }
+
+    Provider m_provider;
+    UnreadMessagePoller m_poller;
+    QHash<QString, Store> m_stores;
+};
+
+}
+
+#endif
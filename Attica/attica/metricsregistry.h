@@ -0,0 +1,289 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_METRICSREGISTRY_H
+#define ATTICA_METRICSREGISTRY_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+
+#include "jobstats.h"
+
+namespace Attica
+{
+
+/**
+ * Aggregates JobStats per provider and endpoint.
+ *
+ * Keep one registry next to the ProviderManager and attach() the
+ * JobStatsRecorder that tracks the jobs. Recording only bumps a handful of
+ * counters and one fixed latency histogram bucket, and may happen from any
+ * thread. Caches can report their hits and misses through recordCacheHit()
+ * and recordCacheMiss().
+ *
+ * The current state can be exported in the Prometheus text format with
+ * toPrometheus() or as JSON with toJson().
+ */
+class MetricsRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsRegistry(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+    /// Records every job that finishes in @p recorder
+    void attach(JobStatsRecorder *recorder)
+    {
+        connect(recorder, &JobStatsRecorder::jobFinished, this, &MetricsRegistry::record, Qt::DirectConnection);
+    }
+
+    void record(const JobStats &stats)
+    {
+        QMutexLocker locker(&m_mutex);
+        Series &series = m_series[qMakePair(stats.provider().toString(), stats.endpoint())];
+        ++series.requests;
+        series.items += stats.itemCount();
+        if (stats.error() != Metadata::NoError) {
+            ++series.errors[qMakePair(int(stats.error()), stats.statusCode())];
+        }
+        const qint64 duration = stats.totalTime();
+        if (duration >= 0) {
+            int bucket = 0;
+            while (bucket < BucketCount && duration > bucketBound(bucket)) {
+                ++bucket;
+            }
+            ++series.latency[bucket];
+            series.latencySum += duration;
+            ++series.latencyCount;
+        }
+    }
+
+    void recordCacheHit(const QUrl &provider, const QString &endpoint)
+    {
+        QMutexLocker locker(&m_mutex);
+        ++m_series[qMakePair(provider.toString(), endpoint)].cacheHits;
+    }
+
+    void recordCacheMiss(const QUrl &provider, const QString &endpoint)
+    {
+        QMutexLocker locker(&m_mutex);
+        ++m_series[qMakePair(provider.toString(), endpoint)].cacheMisses;
+    }
+
+    void clear()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_series.clear();
+    }
+
+    /**
+     * The latency below which @p quantile (0..1) of the requests of one
+     * provider and endpoint finished, in microseconds.
+     * Interpolated linearly inside the histogram bucket; -1 if nothing was recorded.
+     */
+    qint64 latencyPercentile(const QUrl &provider, const QString &endpoint, qreal quantile) const
+    {
+        QMutexLocker locker(&m_mutex);
+        return percentile(m_series.value(qMakePair(provider.toString(), endpoint)), quantile);
+    }
+
+    /// Snapshot in the Prometheus text exposition format
+    QByteArray toPrometheus() const
+    {
+        QMutexLocker locker(&m_mutex);
+        QStringList lines;
+
+        lines << QStringLiteral("# HELP attica_requests_total Finished Attica jobs.")
+              << QStringLiteral("# TYPE attica_requests_total counter");
+        for (SeriesHash::const_iterator it = m_series.constBegin(); it != m_series.constEnd(); ++it) {
+            lines << QStringLiteral("attica_requests_total{%1} %2").arg(labels(it.key()), QString::number(it->requests));
+        }
+
+        lines << QStringLiteral("# HELP attica_errors_total Failed Attica jobs by error type and status code.")
+              << QStringLiteral("# TYPE attica_errors_total counter");
+        for (SeriesHash::const_iterator it = m_series.constBegin(); it != m_series.constEnd(); ++it) {
+            for (ErrorMap::const_iterator error = it->errors.constBegin(); error != it->errors.constEnd(); ++error) {
+                lines << QStringLiteral("attica_errors_total{%1,error=\"%2\",status=\"%3\"} %4")
+                             .arg(labels(it.key()), errorName(error.key().first),
+                                  QString::number(error.key().second), QString::number(error.value()));
+            }
+        }
+
+        lines << QStringLiteral("# HELP attica_request_duration_seconds Time from creating an Attica job until it finished.")
+              << QStringLiteral("# TYPE attica_request_duration_seconds histogram");
+        for (SeriesHash::const_iterator it = m_series.constBegin(); it != m_series.constEnd(); ++it) {
+            const QString seriesLabels = labels(it.key());
+            quint64 cumulative = 0;
+            for (int bucket = 0; bucket <= BucketCount; ++bucket) {
+                cumulative += it->latency[bucket];
+                const QString bound = bucket < BucketCount ? QString::number(bucketBound(bucket) / 1e6) : QStringLiteral("+Inf");
+                lines << QStringLiteral("attica_request_duration_seconds_bucket{%1,le=\"%2\"} %3").arg(seriesLabels, bound, QString::number(cumulative));
+            }
+            lines << QStringLiteral("attica_request_duration_seconds_sum{%1} %2").arg(seriesLabels, QString::number(it->latencySum / 1e6))
+                  << QStringLiteral("attica_request_duration_seconds_count{%1} %2").arg(seriesLabels, QString::number(it->latencyCount));
+        }
+
+        lines << QStringLiteral("# HELP attica_items_parsed_total Items parsed from Attica responses.")
+              << QStringLiteral("# TYPE attica_items_parsed_total counter");
+        for (SeriesHash::const_iterator it = m_series.constBegin(); it != m_series.constEnd(); ++it) {
+            lines << QStringLiteral("attica_items_parsed_total{%1} %2").arg(labels(it.key()), QString::number(it->items));
+        }
+
+        lines << QStringLiteral("# HELP attica_cache_requests_total Lookups answered by Attica caches.")
+              << QStringLiteral("# TYPE attica_cache_requests_total counter");
+        for (SeriesHash::const_iterator it = m_series.constBegin(); it != m_series.constEnd(); ++it) {
+            const QString seriesLabels = labels(it.key());
+            lines << QStringLiteral("attica_cache_requests_total{%1,result=\"hit\"} %2").arg(seriesLabels, QString::number(it->cacheHits))
+                  << QStringLiteral("attica_cache_requests_total{%1,result=\"miss\"} %2").arg(seriesLabels, QString::number(it->cacheMisses));
+        }
+
+        return lines.join(QLatin1Char('\n')).toUtf8() + '\n';
+    }
+
+    /// Snapshot as a JSON array with one object per provider and endpoint
+    QByteArray toJson() const
+    {
+        QMutexLocker locker(&m_mutex);
+        QJsonArray array;
+        for (SeriesHash::const_iterator it = m_series.constBegin(); it != m_series.constEnd(); ++it) {
+            QJsonObject errors;
+            for (ErrorMap::const_iterator error = it->errors.constBegin(); error != it->errors.constEnd(); ++error) {
+                errors.insert(QStringLiteral("%1/%2").arg(errorName(error.key().first), QString::number(error.key().second)), double(error.value()));
+            }
+            const quint64 lookups = it->cacheHits + it->cacheMisses;
+
+            QJsonObject object;
+            object.insert(QStringLiteral("provider"), it.key().first);
+            object.insert(QStringLiteral("endpoint"), it.key().second);
+            object.insert(QStringLiteral("requests"), double(it->requests));
+            object.insert(QStringLiteral("errors"), errors);
+            object.insert(QStringLiteral("itemsParsed"), double(it->items));
+            object.insert(QStringLiteral("latencyP50Us"), double(percentile(*it, 0.5)));
+            object.insert(QStringLiteral("latencyP90Us"), double(percentile(*it, 0.9)));
+            object.insert(QStringLiteral("latencyP99Us"), double(percentile(*it, 0.99)));
+            object.insert(QStringLiteral("cacheHits"), double(it->cacheHits));
+            object.insert(QStringLiteral("cacheMisses"), double(it->cacheMisses));
+            object.insert(QStringLiteral("cacheHitRatio"), lookups ? double(it->cacheHits) / lookups : 0.0);
+            array.append(object);
+        }
+        return QJsonDocument(array).toJson(QJsonDocument::Compact);
+    }
+
+private:
+    // upper bounds of the latency buckets, the last bucket catches everything above
+    enum { BucketCount = 12 };
+    static qint64 bucketBound(int bucket)
+    {
+        static const qint64 bounds[BucketCount] = {
+            5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000, 30000000
+        };
+        return bounds[bucket];
+    }
+
+    typedef QPair<QString, QString> SeriesKey;
+    typedef QMap<QPair<int, int>, quint64> ErrorMap;
+
+    struct Series {
+        Series()
+            : requests(0), items(0), latencySum(0), latencyCount(0), cacheHits(0), cacheMisses(0)
+        {
+            for (int i = 0; i <= BucketCount; ++i) {
+                latency[i] = 0;
+            }
+        }
+        quint64 requests;
+        quint64 items;
+        ErrorMap errors;
+        quint64 latency[BucketCount + 1];
+        qint64 latencySum;
+        quint64 latencyCount;
+        quint64 cacheHits;
+        quint64 cacheMisses;
+    };
+    typedef QHash<SeriesKey, Series> SeriesHash;
+
+    static qint64 percentile(const Series &series, qreal quantile)
+    {
+        if (series.latencyCount == 0) {
+            return -1;
+        }
+        const qreal rank = quantile * series.latencyCount;
+        quint64 cumulative = 0;
+        for (int bucket = 0; bucket <= BucketCount; ++bucket) {
+            const quint64 count = series.latency[bucket];
+            if (count && cumulative + count >= rank) {
+                const qint64 lower = bucket ? bucketBound(bucket - 1) : 0;
+                if (bucket == BucketCount) {
+                    return lower;
+                }
+                return lower + qint64((bucketBound(bucket) - lower) * ((rank - cumulative) / count));
+            }
+            cumulative += count;
+        }
+        return bucketBound(BucketCount - 1);
+    }
+
+    static QString errorName(int error)
+    {
+        switch (error) {
+        case Metadata::NetworkError:
+            return QStringLiteral("NetworkError");
+        case Metadata::OcsError:
+            return QStringLiteral("OcsError");
+        default:
+            return QStringLiteral("NoError");
+        }
+    }
+
+    static QString escape(QString value)
+    {
+        return value.replace(QLatin1Char('\\'), QLatin1String("\\\\"))
+                    .replace(QLatin1Char('"'), QLatin1String("\\\""))
+                    .replace(QLatin1Char('\n'), QLatin1String("\\n"));
+    }
+
+    static QString labels(const SeriesKey &key)
+    {
+        return QStringLiteral("provider=\"%1\",endpoint=\"%2\"").arg(escape(key.first), escape(key.second));
+    }
+
+    mutable QMutex m_mutex;
+    SeriesHash m_series;
+};
+
+}
+
+#endif
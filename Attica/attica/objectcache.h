@@ -0,0 +1,204 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_OBJECTCACHE_H
+#define ATTICA_OBJECTCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QUrl>
+
+#include <typeinfo>
+
+#include "content.h"
+#include "itemjob.h"
+#include "knowledgebaseentry.h"
+#include "listjob.h"
+#include "provider.h"
+#include "sharedinstances.h"
+
+namespace Attica
+{
+
+/**
+ * An in-memory cache of parsed objects of one Provider, keyed by type and id.
+ *
+ * Pass jobs through watch() to store what they return: single objects from
+ * ItemJobs as well as every item of a ListJob, so that a detail view opened
+ * from a list finds its object here without a request.
+ *
+ * For Content and KnowledgeBaseEntry the modification date decides: an
+ * object only replaces a cached one that was modified earlier. The least
+ * recently used objects are dropped when the estimated size of all objects
+ * exceeds maxCost() bytes.
+ *
+ * The cache is shared; see SharedInstances for the thread to use it from.
+ */
+class ObjectCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// The cache shared by all copies of @p provider, see SharedInstances
+    static ObjectCache *forProvider(const Provider &provider)
+    {
+        return SharedInstances<ObjectCache>::instance(provider.baseUrl(), [&](QObject *parent) {
+            return new ObjectCache(parent);
+        });
+    }
+
+    explicit ObjectCache(QObject *parent = nullptr)
+        : QObject(parent)
+        , m_objects(8 * 1024 * 1024)
+    {
+    }
+
+    /// The budget for all cached objects in bytes (estimated)
+    int maxCost() const { return m_objects.maxCost(); }
+    void setMaxCost(int bytes) { m_objects.setMaxCost(bytes); }
+    int totalCost() const { return m_objects.totalCost(); }
+
+    template <class T>
+    void insert(const T &item)
+    {
+        if (item.id().isEmpty()) {
+            return;
+        }
+        const Key key = makeKey<T>(item.id());
+        const Holder<T> *cached = static_cast<Holder<T> *>(m_objects.object(key));
+        if (cached) {
+            // undated objects always replace the cached one, dated ones only if newer
+            const QDateTime cachedModified = lastModified(cached->item);
+            if (cachedModified.isValid() && cachedModified >= lastModified(item)) {
+                return;
+            }
+        }
+        m_objects.insert(key, new Holder<T>(item), cost(item));
+    }
+
+    template <class T>
+    void insert(const QList<T> &items)
+    {
+        for (const T &item : items) {
+            insert(item);
+        }
+    }
+
+    template <class T>
+    bool contains(const QString &id) const
+    {
+        return m_objects.contains(makeKey<T>(id));
+    }
+
+    /**
+     * The cached object of type @p T with @p id, or a default constructed one.
+     * Marks the object as recently used.
+     */
+    template <class T>
+    T object(const QString &id)
+    {
+        const Holder<T> *cached = static_cast<Holder<T> *>(m_objects.object(makeKey<T>(id)));
+        return cached ? cached->item : T();
+    }
+
+    template <class T>
+    void remove(const QString &id)
+    {
+        m_objects.remove(makeKey<T>(id));
+    }
+
+    void clear()
+    {
+        m_objects.clear();
+    }
+
+    /// Stores the result of @p job once it finished successfully
+    template <class T>
+    ItemJob<T> *watch(ItemJob<T> *job)
+    {
+        connect(job, &BaseJob::finished, this, [this](BaseJob *baseJob) {
+            if (baseJob->metadata().error() == Metadata::NoError) {
+                insert(static_cast<ItemJob<T> *>(baseJob)->result());
+            }
+        });
+        return job;
+    }
+
+    /// Stores all items returned by @p job once it finished successfully
+    template <class T>
+    ListJob<T> *watch(ListJob<T> *job)
+    {
+        connect(job, &BaseJob::finished, this, [this](BaseJob *baseJob) {
+            if (baseJob->metadata().error() == Metadata::NoError) {
+                insert(static_cast<ListJob<T> *>(baseJob)->itemList());
+            }
+        });
+        return job;
+    }
+
+private:
+    typedef QPair<QByteArray, QString> Key;
+
+    struct HolderBase {
+        virtual ~HolderBase() {}
+    };
+
+    template <class T>
+    struct Holder : HolderBase {
+        explicit Holder(const T &item) : item(item) {}
+        T item;
+    };
+
+    template <class T>
+    static Key makeKey(const QString &id)
+    {
+        return Key(QByteArray(typeid(T).name()), id);
+    }
+
+    template <class T>
+    static QDateTime lastModified(const T &) { return QDateTime(); }
+    static QDateTime lastModified(const Content &content) { return content.updated(); }
+    static QDateTime lastModified(const KnowledgeBaseEntry &entry) { return entry.changed(); }
+
+    // rough size of an object in memory, only used to weigh objects against each other
+    template <class T>
+    static int cost(const T &) { return 512; }
+    static int cost(const Content &content)
+    {
+        int size = 256 + 2 * (content.name().size() + content.description().size());
+        const QMap<QString, QString> attributes = content.attributes();
+        for (QMap<QString, QString>::const_iterator it = attributes.constBegin(); it != attributes.constEnd(); ++it) {
+            size += 64 + 2 * (it.key().size() + it.value().size());
+        }
+        return size;
+    }
+
+    QCache<Key, HolderBase> m_objects;
+};
+
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+
+#ifndef ATTICA_PLATFORMDEPENDENT_V3_H
+#define ATTICA_PLATFORMDEPENDENT_V3_H
+
+#include <QList>
+#include <QString>
+#include <QUrl>
+#include <QtPlugin>
+
+#include <functional>
+
+#include <platformdependent_v2.h>
+
+namespace Attica
+{
+
+/**
+ * Adds non-blocking credential access to PlatformDependentV2.
+ *
+ * Plugins backed by a slow store (like a wallet that has to be opened and
+ * unlocked first) implement these so that callers can keep the event loop
+ * running while the store answers.
+ */
+class PlatformDependentV3: public PlatformDependentV2
+{
+public:
+    /**
+     * Called once the credentials are known.
+     * @param found whether credentials were available
+     */
+    typedef std::function<void(bool found, const QString &user, const QString &password)> CredentialsCallback;
+
+    virtual ~PlatformDependentV3() {}
+
+    /**
+     * Non-blocking version of loadCredentials().
+     * @p callback is invoked later from the event loop of the calling thread,
+     * never from within this call.
+     */
+    virtual void loadCredentials(const QUrl &baseUrl, const CredentialsCallback &callback) = 0;
+
+    /**
+     * Non-blocking version of askForCredentials().
+     * @p callback is invoked later from the event loop of the calling thread.
+     */
+    virtual void askForCredentials(const QUrl &baseUrl, const CredentialsCallback &callback) = 0;
+
+    /**
+     * Starts loading the credentials of all @p baseUrls at once, so that the
+     * answers are ready by the time the first authenticated request needs them.
+     * Plugins that can fetch several entries in one go should override this.
+     */
+    virtual void preloadCredentials(const QList<QUrl> &baseUrls)
+    {
+        for (const QUrl &baseUrl : baseUrls) {
+            loadCredentials(baseUrl, [](bool, const QString &, const QString &) {});
+        }
+    }
+
+    using PlatformDependent::loadCredentials;
+    using PlatformDependent::askForCredentials;
+};
+
+}
+
+Q_DECLARE_INTERFACE(Attica::PlatformDependentV3, "org.kde.Attica.InternalsV3/1.2")
+
+#endif
@@ -0,0 +1,251 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_PROVIDERFILECACHE_H
+#define ATTICA_PROVIDERFILECACHE_H
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QPointer>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUrl>
+#include <QXmlStreamReader>
+
+#include "providermanager.h"
+
+namespace Attica
+{
+
+/**
+ * Keeps the last good copy of the default provider files on disk.
+ *
+ * Use load() in place of ProviderManager::loadDefaultProviders(). The
+ * providers from the cached files are added to the manager synchronously,
+ * so they are usable right after load() returns. All provider files are then
+ * fetched again in parallel in the background, and a file is only handed
+ * to the manager again (and providerAdded emitted) when its content changed.
+ * A reply that does not parse as a provider file, e.g. the login page of a
+ * captive portal, is ignored and the last good copy is kept.
+ *
+ * ProviderManager::defaultProvidersLoaded() is emitted once, right after
+ * load() if all files came from the cache, otherwise when the first
+ * revalidation finished.
+ *
+ * The files are downloaded with a private QNetworkAccessManager unless
+ * setNetworkAccessManager() is called; pass the one your PlatformDependent
+ * hands out from nam() so that its proxy and authentication setup applies.
+ *
+ * \code
+ * ProviderManager manager;
+ * ProviderFileCache cache(&manager);
+ * connect(&manager, &ProviderManager::providerAdded, ...);
+ * cache.load();
+ * \endcode
+ */
+class ProviderFileCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param manager the manager the providers are added to
+     * @param directory where the provider files are kept, by default a
+     * directory in QStandardPaths::CacheLocation
+     */
+    explicit ProviderFileCache(ProviderManager *manager, const QString &directory = QString(), QObject *parent = nullptr)
+        : QObject(parent)
+        , m_manager(manager)
+        , m_directory(directory.isEmpty()
+                      ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/attica/providerfiles")
+                      : directory)
+        , m_pending(0)
+        , m_announceDefaults(false)
+    {
+    }
+
+    /// The manager used for downloads, the private one if none was set
+    QNetworkAccessManager *networkAccessManager()
+    {
+        return m_externalNam ? m_externalNam.data() : &m_nam;
+    }
+
+    /// Uses @p nam for downloads; it is not owned by the cache
+    void setNetworkAccessManager(QNetworkAccessManager *nam) { m_externalNam = nam; }
+
+    /**
+     * Adds the cached providers for ProviderManager::defaultProviderFiles()
+     * to the manager and starts revalidating all of them.
+     * @return the number of provider files that were available from the cache
+     */
+    int load()
+    {
+        const QList<QUrl> files = m_manager->defaultProviderFiles();
+        int cached = 0;
+        for (const QUrl &url : files) {
+            QFile file(cacheFile(url));
+            if (!m_cached.contains(url) && file.open(QIODevice::ReadOnly)) {
+                const QByteArray data = file.readAll();
+                if (!isProviderFile(data)) {
+                    continue;
+                }
+                m_cached.insert(url, hash(data));
+                m_manager->addProviderFromXml(QString::fromUtf8(data));
+                ++cached;
+            }
+        }
+        m_announceDefaults = true;
+        if (cached == files.size()) {
+            QTimer::singleShot(0, this, &ProviderFileCache::announceDefaults);
+        }
+        revalidate(files);
+        return cached;
+    }
+
+    /// Fetches @p files again and updates the manager for those that changed
+    void revalidate(const QList<QUrl> &files)
+    {
+        for (const QUrl &url : files) {
+            if (url.isLocalFile()) {
+                QFile file(url.toLocalFile());
+                if (file.open(QIODevice::ReadOnly)) {
+                    update(url, file.readAll());
+                } else {
+                    emit failedToLoad(url, QNetworkReply::ContentNotFoundError);
+                }
+                continue;
+            }
+
+            QNetworkRequest request(url);
+            request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+            QNetworkReply *reply = networkAccessManager()->get(request);
+            ++m_pending;
+            connect(reply, &QNetworkReply::finished, this, [this, reply, url]() {
+                reply->deleteLater();
+                if (reply->error() == QNetworkReply::NoError) {
+                    update(url, reply->readAll());
+                } else {
+                    emit failedToLoad(url, reply->error());
+                }
+                if (--m_pending == 0) {
+                    announceDefaults();
+                    emit revalidated();
+                }
+            });
+        }
+        if (m_pending == 0) {
+            announceDefaults();
+            emit revalidated();
+        }
+    }
+
+Q_SIGNALS:
+    /// All provider files have been fetched again
+    void revalidated();
+    void failedToLoad(const QUrl &providerFile, QNetworkReply::NetworkError error);
+
+private:
+    static QByteArray hash(const QByteArray &data)
+    {
+        return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    }
+
+    QString cacheFile(const QUrl &url) const
+    {
+        return m_directory + QLatin1Char('/') + QString::fromLatin1(hash(url.toEncoded()).toHex()) + QStringLiteral(".xml");
+    }
+
+    // the same structure ProviderManager expects: providers with a location each
+    static bool isProviderFile(const QByteArray &data)
+    {
+        QXmlStreamReader xml(data);
+        if (!xml.readNextStartElement() || xml.name() != QLatin1String("providers")) {
+            return false;
+        }
+        int providers = 0;
+        bool hasLocation = false;
+        while (!xml.atEnd()) {
+            xml.readNext();
+            if (!xml.isStartElement()) {
+                continue;
+            }
+            if (xml.name() == QLatin1String("provider")) {
+                if (providers > 0 && !hasLocation) {
+                    return false;
+                }
+                ++providers;
+                hasLocation = false;
+            } else if (xml.name() == QLatin1String("location")) {
+                hasLocation = !xml.readElementText().trimmed().isEmpty();
+            }
+        }
+        return !xml.hasError() && providers > 0 && hasLocation;
+    }
+
+    void announceDefaults()
+    {
+        if (m_announceDefaults) {
+            m_announceDefaults = false;
+            emit m_manager->defaultProvidersLoaded();
+        }
+    }
+
+    void update(const QUrl &url, const QByteArray &data)
+    {
+        if (!isProviderFile(data)) {
+            emit failedToLoad(url, QNetworkReply::UnknownContentError);
+            return;
+        }
+        const QByteArray dataHash = hash(data);
+        if (m_cached.value(url) == dataHash) {
+            return;
+        }
+        m_cached.insert(url, dataHash);
+        m_manager->addProviderFromXml(QString::fromUtf8(data));
+
+        QDir().mkpath(m_directory);
+        QSaveFile file(cacheFile(url));
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(data);
+            file.commit();
+        }
+    }
+
+    ProviderManager *m_manager;
+    const QString m_directory;
+    QNetworkAccessManager m_nam;
+    QPointer<QNetworkAccessManager> m_externalNam;
+    QHash<QUrl, QByteArray> m_cached;
+    int m_pending;
+    bool m_announceDefaults;
+};
+
+}
+
+#endif
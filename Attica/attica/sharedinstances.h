@@ -0,0 +1,79 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_SHAREDINSTANCES_H
+#define ATTICA_SHAREDINSTANCES_H
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QPointer>
+#include <QThread>
+#include <QUrl>
+
+namespace Attica
+{
+
+/**
+ * The registry behind the forProvider() functions of the helper classes:
+ * one instance of T per key, usually the base url of a Provider, so that all
+ * copies of a Provider share it.
+ *
+ * Instances are created on first use with QCoreApplication as parent and
+ * live as long as the application, unless they are deleted earlier, in
+ * which case the next call creates a new one. Only use them from the thread
+ * the QCoreApplication lives in.
+ *
+ * The helpers are not part of libKF5Attica but compiled into each module
+ * that includes them, so a plugin or library that includes the header gets
+ * its own instances instead of sharing those of the application.
+ */
+template <class T, class Key = QUrl>
+class SharedInstances
+{
+public:
+    /**
+     * The instance for @p key, created with @p create if there is none.
+     * @param create called with the parent for the new instance, returns the new instance
+     */
+    template <class Create>
+    static T *instance(const Key &key, Create create)
+    {
+        Q_ASSERT_X(!QCoreApplication::instance() || QThread::currentThread() == QCoreApplication::instance()->thread(),
+                   "Attica::SharedInstances", "shared instances are only available on the main thread");
+        QPointer<T> &object = registry()[key];
+        if (!object) {
+            object = create(QCoreApplication::instance());
+        }
+        return object;
+    }
+
+private:
+    static QHash<Key, QPointer<T> > &registry()
+    {
+        static QHash<Key, QPointer<T> > instances;
+        return instances;
+    }
+};
+
+}
+
+#endif
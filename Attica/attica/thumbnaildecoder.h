@@ -0,0 +1,237 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_THUMBNAILDECODER_H
+#define ATTICA_THUMBNAILDECODER_H
+
+#include <QAtomicInt>
+#include <QBuffer>
+#include <QCache>
+#include <QCoreApplication>
+#include <QEvent>
+#include <QHash>
+#include <QImage>
+#include <QImageReader>
+#include <QObject>
+#include <QRunnable>
+#include <QSharedPointer>
+#include <QSize>
+#include <QThreadPool>
+#include <QUrl>
+
+#include "previewcache.h"
+
+namespace Attica
+{
+
+/**
+ * Decodes and downscales images from a PreviewCache on worker threads.
+ *
+ * request() emits thumbnailAvailable() with an image scaled to fit the
+ * requested size. Decoded images are kept in a memory cache limited to
+ * maxCost() KiB, so rows scrolling back into view do not decode again.
+ * Work for rows that scrolled out of view can be dropped with cancel().
+ *
+ * Unlike the rest of Attica this class needs QtGui; attica.pri only lists
+ * it for moc when the project uses the gui module.
+ */
+class ThumbnailDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ThumbnailDecoder(PreviewCache *cache, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_cache(cache)
+        , m_images(64 * 1024)
+    {
+        connect(cache, &PreviewCache::imageAvailable, this, &ThumbnailDecoder::imageAvailable);
+        connect(cache, &PreviewCache::imageFailed, this, [this](const QUrl &url) {
+            m_waiting.remove(url);
+        });
+    }
+
+    ~ThumbnailDecoder()
+    {
+        for (QHash<QString, QSharedPointer<QAtomicInt> >::const_iterator it = m_running.constBegin(); it != m_running.constEnd(); ++it) {
+            (*it)->store(1);
+        }
+        m_pool.waitForDone();
+    }
+
+    /// The budget for decoded images in KiB, 64 MiB by default
+    int maxCost() const { return m_images.maxCost(); }
+    void setMaxCost(int kibibytes) { m_images.setMaxCost(kibibytes); }
+
+    /// The pool the images are decoded in, e.g. to limit its thread count
+    QThreadPool *threadPool() { return &m_pool; }
+
+    void request(const QUrl &url, const QSize &size, PreviewCache::Priority priority = PreviewCache::Visible)
+    {
+        const QString key = imageKey(url, size);
+        if (const QImage *image = m_images.object(key)) {
+            emit thumbnailAvailable(url, size, *image);
+            return;
+        }
+        if (m_running.contains(key)) {
+            return;
+        }
+        // the cache counts requests, so each url is requested once however many sizes wait for it
+        QHash<QUrl, Waiting>::iterator waiting = m_waiting.find(url);
+        if (waiting == m_waiting.end()) {
+            waiting = m_waiting.insert(url, Waiting());
+            waiting->sizes.append(size);
+            waiting->priority = priority;
+            m_cache->request(url, priority);
+            return;
+        }
+        if (!waiting->sizes.contains(size)) {
+            waiting->sizes.append(size);
+        }
+        if (priority > waiting->priority) {
+            waiting->priority = priority;
+            m_cache->setPriority(url, priority);
+        }
+    }
+
+    /// Stops waiting for @p url at @p size and drops its decoding if it has not finished
+    void cancel(const QUrl &url, const QSize &size)
+    {
+        QHash<QUrl, Waiting>::iterator waiting = m_waiting.find(url);
+        if (waiting != m_waiting.end()) {
+            waiting->sizes.removeAll(size);
+            if (waiting->sizes.isEmpty()) {
+                m_waiting.erase(waiting);
+                m_cache->cancel(url);
+            }
+        }
+        QSharedPointer<QAtomicInt> cancelled = m_running.take(imageKey(url, size));
+        if (cancelled) {
+            cancelled->store(1);
+        }
+    }
+
+Q_SIGNALS:
+    void thumbnailAvailable(const QUrl &url, const QSize &size, const QImage &image);
+
+protected:
+    bool event(QEvent *event) override
+    {
+        if (event->type() != decodedEventType()) {
+            return QObject::event(event);
+        }
+        DecodedEvent *decoded = static_cast<DecodedEvent *>(event);
+        const QString key = imageKey(decoded->url, decoded->size);
+        QHash<QString, QSharedPointer<QAtomicInt> >::iterator running = m_running.find(key);
+        if (running == m_running.end() || *running != decoded->cancelled) {
+            return true;
+        }
+        m_running.erase(running);
+        if (!decoded->cancelled->load() && !decoded->image.isNull()) {
+            m_images.insert(key, new QImage(decoded->image), int(qMax<qsizetype>(1, decoded->image.sizeInBytes() / 1024)));
+            emit thumbnailAvailable(decoded->url, decoded->size, decoded->image);
+        }
+        return true;
+    }
+
+private:
+    struct Waiting {
+        QList<QSize> sizes;
+        PreviewCache::Priority priority;
+    };
+
+    struct DecodedEvent : QEvent {
+        DecodedEvent(const QUrl &url, const QSize &size, const QImage &image, const QSharedPointer<QAtomicInt> &cancelled)
+            : QEvent(decodedEventType()), url(url), size(size), image(image), cancelled(cancelled)
+        {
+        }
+        QUrl url;
+        QSize size;
+        QImage image;
+        QSharedPointer<QAtomicInt> cancelled;
+    };
+
+    class DecodeTask : public QRunnable
+    {
+    public:
+        DecodeTask(ThumbnailDecoder *decoder, const QUrl &url, const QSize &size, const QByteArray &data,
+                   const QSharedPointer<QAtomicInt> &cancelled)
+            : m_decoder(decoder), m_url(url), m_size(size), m_data(data), m_cancelled(cancelled)
+        {
+        }
+
+        void run() override
+        {
+            QImage image;
+            if (!m_cancelled->load()) {
+                QBuffer buffer(&m_data);
+                QImageReader reader(&buffer);
+                const QSize original = reader.size();
+                if (original.isValid() && (original.width() > m_size.width() || original.height() > m_size.height())) {
+                    reader.setScaledSize(original.scaled(m_size, Qt::KeepAspectRatio));
+                }
+                if (!m_cancelled->load()) {
+                    image = reader.read();
+                }
+            }
+            QCoreApplication::postEvent(m_decoder, new DecodedEvent(m_url, m_size, image, m_cancelled));
+        }
+
+    private:
+        ThumbnailDecoder *m_decoder;
+        QUrl m_url;
+        QSize m_size;
+        QByteArray m_data;
+        QSharedPointer<QAtomicInt> m_cancelled;
+    };
+
+    static QEvent::Type decodedEventType()
+    {
+        static const QEvent::Type type = QEvent::Type(QEvent::registerEventType());
+        return type;
+    }
+
+    static QString imageKey(const QUrl &url, const QSize &size)
+    {
+        return QStringLiteral("%1x%2@").arg(size.width()).arg(size.height()) + url.toString();
+    }
+
+    void imageAvailable(const QUrl &url, const QByteArray &data)
+    {
+        const QList<QSize> sizes = m_waiting.take(url).sizes;
+        for (const QSize &size : sizes) {
+            QSharedPointer<QAtomicInt> cancelled(new QAtomicInt(0));
+            m_running.insert(imageKey(url, size), cancelled);
+            m_pool.start(new DecodeTask(this, url, size, data, cancelled));
+        }
+    }
+
+    PreviewCache *m_cache;
+    QThreadPool m_pool;
+    QCache<QString, QImage> m_images;
+    QHash<QUrl, Waiting> m_waiting;
+    QHash<QString, QSharedPointer<QAtomicInt> > m_running;
+};
+
+}
+
+#endif
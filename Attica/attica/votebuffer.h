@@ -0,0 +1,230 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_VOTEBUFFER_H
+#define ATTICA_VOTEBUFFER_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QTimer>
+#include <QUrl>
+
+#include "metadata.h"
+#include "postjob.h"
+#include "provider.h"
+#include "sharedinstances.h"
+
+namespace Attica
+{
+
+/**
+ * Collects votes for content and comments before they are sent.
+ *
+ * Users often change their mind a few times in a row. A vote is held back
+ * for window() milliseconds after the last change to the same target and
+ * only the final rating is sent with Provider::voteForContent() or
+ * Provider::voteForComment(). At most maxConcurrentRequests() votes are
+ * sent at the same time.
+ *
+ * Until the server confirmed it, a vote is reported by pendingRating(), so
+ * a user interface can show it right away.
+ */
+class VoteBuffer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Target {
+        ContentVote,
+        CommentVote
+    };
+
+    /// The buffer shared by all copies of @p provider, see SharedInstances
+    static VoteBuffer *forProvider(const Provider &provider)
+    {
+        return SharedInstances<VoteBuffer>::instance(provider.baseUrl(), [&](QObject *parent) {
+            return new VoteBuffer(provider, parent);
+        });
+    }
+
+    explicit VoteBuffer(const Provider &provider, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_window(2000)
+        , m_maxConcurrentRequests(4)
+        , m_running(0)
+    {
+        m_timer.setSingleShot(true);
+        connect(&m_timer, &QTimer::timeout, this, &VoteBuffer::submitDue);
+    }
+
+    /// Milliseconds a vote is held back after its last change, 2 seconds by default
+    int window() const { return m_window; }
+    void setWindow(int msecs) { m_window = qMax(0, msecs); }
+
+    int maxConcurrentRequests() const { return m_maxConcurrentRequests; }
+    void setMaxConcurrentRequests(int count) { m_maxConcurrentRequests = qMax(1, count); }
+
+    /**
+     * Votes @p rating (0 to 100) for the target @p id, replacing a vote for it not yet sent.
+     */
+    void vote(Target target, const QString &id, uint rating)
+    {
+        const Key key(target, id);
+        Vote &vote = m_pending[key];
+        vote.rating = qMin(rating, 100u);
+        vote.due = QDateTime::currentMSecsSinceEpoch() + m_window;
+        m_ready.removeOne(key);
+        schedule();
+    }
+
+    void voteForContent(const QString &contentId, uint rating) { vote(ContentVote, contentId, rating); }
+    void voteForComment(const QString &commentId, uint rating) { vote(CommentVote, commentId, rating); }
+
+    /// Drops a vote that was not sent yet; returns false if there is none
+    bool cancel(Target target, const QString &id)
+    {
+        const Key key(target, id);
+        m_ready.removeOne(key);
+        const bool removed = m_pending.remove(key) > 0;
+        schedule();
+        return removed;
+    }
+
+    /// Sends all held back votes without waiting for their window to pass
+    void flush()
+    {
+        for (QHash<Key, Vote>::iterator it = m_pending.begin(); it != m_pending.end(); ++it) {
+            it->due = 0;
+        }
+        submitDue();
+    }
+
+    /// Whether a vote for @p id is held back or not yet confirmed
+    bool isPending(Target target, const QString &id) const
+    {
+        const Key key(target, id);
+        return m_pending.contains(key) || m_inFlight.contains(key);
+    }
+
+    /// The latest rating voted for @p id that the server did not confirm yet, or -1
+    int pendingRating(Target target, const QString &id) const
+    {
+        const Key key(target, id);
+        QHash<Key, Vote>::const_iterator it = m_pending.constFind(key);
+        if (it != m_pending.constEnd()) {
+            return int(it->rating);
+        }
+        return m_inFlight.contains(key) ? int(m_inFlight.value(key)) : -1;
+    }
+
+    /// The number of votes held back or not yet confirmed
+    int pendingCount() const { return m_pending.size() + m_inFlight.size(); }
+
+Q_SIGNALS:
+    void voteSubmitted(Attica::VoteBuffer::Target target, const QString &id, uint rating);
+    void voteFailed(Attica::VoteBuffer::Target target, const QString &id, uint rating, const Attica::Metadata &metadata);
+
+private:
+    typedef QPair<int, QString> Key;
+
+    struct Vote {
+        Vote() : rating(0), due(0) {}
+        uint rating;
+        qint64 due;
+    };
+
+    void schedule()
+    {
+        qint64 next = -1;
+        for (QHash<Key, Vote>::const_iterator it = m_pending.constBegin(); it != m_pending.constEnd(); ++it) {
+            if (!m_ready.contains(it.key()) && (next < 0 || it->due < next)) {
+                next = it->due;
+            }
+        }
+        if (next < 0) {
+            m_timer.stop();
+            return;
+        }
+        m_timer.start(int(qMax(qint64(0), next - QDateTime::currentMSecsSinceEpoch())));
+    }
+
+    void submitDue()
+    {
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        for (QHash<Key, Vote>::const_iterator it = m_pending.constBegin(); it != m_pending.constEnd(); ++it) {
+            if (it->due <= now && !m_ready.contains(it.key())) {
+                m_ready.append(it.key());
+            }
+        }
+        startRequests();
+        schedule();
+    }
+
+    void startRequests()
+    {
+        // a target with a vote in flight waits, so votes arrive in order
+        QList<Key>::iterator it = m_ready.begin();
+        while (it != m_ready.end() && m_running < m_maxConcurrentRequests) {
+            const Key key = *it;
+            if (m_inFlight.contains(key)) {
+                ++it;
+                continue;
+            }
+            it = m_ready.erase(it);
+            const uint rating = m_pending.take(key).rating;
+            m_inFlight.insert(key, rating);
+            ++m_running;
+
+            PostJob *job = key.first == ContentVote ? m_provider.voteForContent(key.second, rating)
+                                                    : m_provider.voteForComment(key.second, rating);
+            connect(job, &BaseJob::finished, this, [this, key, rating](BaseJob *baseJob) {
+                --m_running;
+                m_inFlight.remove(key);
+                const Metadata metadata = baseJob->metadata();
+                startRequests();
+                if (metadata.error() == Metadata::NoError) {
+                    emit voteSubmitted(Target(key.first), key.second, rating);
+                } else {
+                    emit voteFailed(Target(key.first), key.second, rating, metadata);
+                }
+            });
+            job->start();
+        }
+    }
+
+    Provider m_provider;
+    QHash<Key, Vote> m_pending;
+    QHash<Key, uint> m_inFlight;
+    QList<Key> m_ready;
+    QTimer m_timer;
+    int m_window;
+    int m_maxConcurrentRequests;
+    int m_running;
+};
+
+}
+
+#endif
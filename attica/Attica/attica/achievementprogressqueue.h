@@ -0,0 +1,307 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_ACHIEVEMENTPROGRESSQUEUE_H
+#define ATTICA_ACHIEVEMENTPROGRESSQUEUE_H
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUrl>
+#include <QVariant>
+
+#include "metadata.h"
+#include "postjob.h"
+#include "provider.h"
+#include "sharedinstances.h"
+
+namespace Attica
+{
+
+/**
+ * A write-behind queue for Provider::setAchievementProgress().
+ *
+ * Games tend to report progress far more often than the server needs to
+ * hear about it. setProgress() only remembers the latest value per
+ * achievement; the queue is sent by flush(), which runs every
+ * flushInterval(), as soon as maxPending() achievements are waiting and
+ * when the application quits.
+ *
+ * Updates that failed with a network error are queued again (unless a newer
+ * value arrived meanwhile) and retried with an increasing delay. Updates the
+ * server refused are dropped and reported through progressFailed().
+ *
+ * Everything not yet confirmed by the server is kept in a file, so progress
+ * made before a crash is sent on the next start.
+ */
+class AchievementProgressQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// The shared queue of @p provider, loaded from its default file; see SharedInstances
+    static AchievementProgressQueue *forProvider(const Provider &provider)
+    {
+        return SharedInstances<AchievementProgressQueue>::instance(provider.baseUrl(), [&](QObject *parent) {
+            return new AchievementProgressQueue(provider, QString(), parent);
+        });
+    }
+
+    /**
+     * Restores the updates left over from a previous run from @p fileName.
+     * @param fileName where unsent updates are kept, by default a file in QStandardPaths::AppDataLocation
+     */
+    explicit AchievementProgressQueue(const Provider &provider, const QString &fileName = QString(), QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_fileName(fileName.isEmpty() ? defaultFileName(provider) : fileName)
+        , m_maxPending(50)
+        , m_retryDelay(0)
+    {
+        m_flushTimer.setInterval(30000);
+        connect(&m_flushTimer, &QTimer::timeout, this, &AchievementProgressQueue::flush);
+        m_flushTimer.start();
+
+        // batches the writes of bursts of setProgress() calls
+        m_saveTimer.setSingleShot(true);
+        m_saveTimer.setInterval(1000);
+        connect(&m_saveTimer, &QTimer::timeout, this, &AchievementProgressQueue::save);
+
+        m_retryTimer.setSingleShot(true);
+        connect(&m_retryTimer, &QTimer::timeout, this, &AchievementProgressQueue::flush);
+
+        if (QCoreApplication::instance()) {
+            connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+                flush();
+                save();
+            });
+        }
+
+        load();
+    }
+
+    ~AchievementProgressQueue() override
+    {
+        if (m_saveTimer.isActive()) {
+            save();
+        }
+    }
+
+    /// Milliseconds between two automatic flushes, 30 seconds by default
+    int flushInterval() const { return m_flushTimer.interval(); }
+    void setFlushInterval(int msecs) { m_flushTimer.setInterval(msecs); }
+
+    /// The number of waiting achievements that triggers a flush right away, 50 by default
+    int maxPending() const { return m_maxPending; }
+    void setMaxPending(int count) { m_maxPending = qMax(1, count); }
+
+    /**
+     * Queues @p progress for the achievement @p id, replacing any value still waiting for it.
+     * An update older than the one already queued is ignored.
+     */
+    void setProgress(const QString &id, const QVariant &progress, const QDateTime &timestamp = QDateTime::currentDateTimeUtc())
+    {
+        QHash<QString, Update>::iterator it = m_pending.find(id);
+        if (it != m_pending.end()) {
+            if (timestamp < it->timestamp) {
+                return;
+            }
+        } else {
+            it = m_pending.insert(id, Update());
+        }
+        it->progress = progress;
+        it->timestamp = timestamp;
+        scheduleSave();
+
+        if (m_pending.size() >= m_maxPending) {
+            flush();
+        }
+    }
+
+    /// The number of achievements with an update not yet sent
+    int pendingCount() const { return m_pending.size(); }
+
+    /// The number of updates sent but not yet confirmed
+    int inFlightCount() const { return m_inFlight.size(); }
+
+    /// The latest progress queued or sent for @p id but not yet confirmed, or an invalid QVariant
+    QVariant pendingProgress(const QString &id) const
+    {
+        QHash<QString, Update>::const_iterator it = m_pending.constFind(id);
+        if (it != m_pending.constEnd()) {
+            return it->progress;
+        }
+        return m_inFlight.value(id).progress;
+    }
+
+    /// Sends all queued updates; achievements with an update in flight wait for it to finish
+    void flush()
+    {
+        QHash<QString, Update>::iterator it = m_pending.begin();
+        while (it != m_pending.end()) {
+            if (m_inFlight.contains(it.key())) {
+                ++it;
+                continue;
+            }
+            const QString id = it.key();
+            const Update update = *it;
+            it = m_pending.erase(it);
+            m_inFlight.insert(id, update);
+
+            PostJob *job = m_provider.setAchievementProgress(id, update.progress, update.timestamp);
+            connect(job, &BaseJob::finished, this, [this, id](BaseJob *baseJob) {
+                finished(id, baseJob->metadata());
+            });
+            job->start();
+        }
+    }
+
+    /// Writes everything not yet confirmed to disk
+    bool save()
+    {
+        m_saveTimer.stop();
+        if (m_pending.isEmpty() && m_inFlight.isEmpty()) {
+            return !QFile::exists(m_fileName) || QFile::remove(m_fileName);
+        }
+
+        QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+        QSaveFile file(m_fileName);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_6);
+
+        // an update in flight may still get lost, so it is stored unless a newer one is queued
+        QHash<QString, Update> updates = m_inFlight;
+        for (QHash<QString, Update>::const_iterator it = m_pending.constBegin(); it != m_pending.constEnd(); ++it) {
+            updates.insert(it.key(), *it);
+        }
+        stream << quint32(Magic) << quint32(Version) << qint32(updates.size());
+        for (QHash<QString, Update>::const_iterator it = updates.constBegin(); it != updates.constEnd(); ++it) {
+            stream << it.key() << it->progress << it->timestamp;
+        }
+        return stream.status() == QDataStream::Ok && file.commit();
+    }
+
+Q_SIGNALS:
+    /// The server accepted the update of @p id
+    void progressSubmitted(const QString &id);
+    /// The server refused the update of @p id; it is not retried
+    void progressFailed(const QString &id, const Attica::Metadata &metadata);
+
+private:
+    enum { Magic = 0x41744170, Version = 1 };
+
+    struct Update {
+        QVariant progress;
+        QDateTime timestamp;
+    };
+
+    static QString defaultFileName(const Provider &provider)
+    {
+        const QByteArray key = QCryptographicHash::hash(provider.baseUrl().toEncoded(), QCryptographicHash::Sha1).toHex();
+        return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+               + QStringLiteral("/attica/achievements/") + QString::fromLatin1(key) + QStringLiteral(".dat");
+    }
+
+    void load()
+    {
+        QFile file(m_fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_6);
+        quint32 magic;
+        quint32 version;
+        qint32 count;
+        stream >> magic >> version >> count;
+        if (magic != Magic || version != Version) {
+            return;
+        }
+        for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+            QString id;
+            Update update;
+            stream >> id >> update.progress >> update.timestamp;
+            if (stream.status() == QDataStream::Ok && !m_pending.contains(id)) {
+                m_pending.insert(id, update);
+            }
+        }
+    }
+
+    void scheduleSave()
+    {
+        if (!m_saveTimer.isActive()) {
+            m_saveTimer.start();
+        }
+    }
+
+    void finished(const QString &id, const Metadata &metadata)
+    {
+        const Update update = m_inFlight.take(id);
+
+        if (metadata.error() == Metadata::NetworkError) {
+            if (!m_pending.contains(id)) {
+                m_pending.insert(id, update);
+            }
+            // back off from 5 seconds up to the flush interval
+            m_retryDelay = qBound(5000, m_retryDelay * 2, qMax(5000, m_flushTimer.interval()));
+            if (!m_retryTimer.isActive()) {
+                m_retryTimer.start(m_retryDelay);
+            }
+            scheduleSave();
+            return;
+        }
+
+        m_retryDelay = 0;
+        scheduleSave();
+        if (metadata.error() == Metadata::NoError) {
+            emit progressSubmitted(id);
+        } else {
+            emit progressFailed(id, metadata);
+        }
+    }
+
+    Provider m_provider;
+    QString m_fileName;
+    QHash<QString, Update> m_pending;
+    QHash<QString, Update> m_inFlight;
+    QTimer m_flushTimer;
+    QTimer m_saveTimer;
+    QTimer m_retryTimer;
+    int m_maxPending;
+    int m_retryDelay;
+};
+
+}
+
+#endif
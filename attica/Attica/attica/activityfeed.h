@@ -0,0 +1,162 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_ACTIVITYFEED_H
+#define ATTICA_ACTIVITYFEED_H
+
+#include <QDateTime>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+#include <algorithm>
+#include <iterator>
+
+#include "activity.h"
+#include "personregistry.h"
+#include "provider.h"
+
+namespace Attica
+{
+
+/**
+ * The activity stream of a Provider, refreshed incrementally.
+ *
+ * refresh() fetches Provider::requestActivities() and passes on only the
+ * activities that were not seen before, deduplicated by id, through
+ * activitiesAdded(). Everything older than the oldest kept activity is
+ * ignored once the feed holds maxCount() entries, so views only ever render
+ * what is new.
+ *
+ * The associated persons are interned through the PersonRegistry of the
+ * provider, so all activities of one user share a single Person.
+ */
+class ActivityFeed : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ActivityFeed(const Provider &provider, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_persons(PersonRegistry::forProvider(provider))
+        , m_maxCount(500)
+        , m_refreshing(false)
+    {
+    }
+
+    /// How many activities the feed keeps, 500 by default
+    int maxCount() const { return m_maxCount; }
+    void setMaxCount(int count)
+    {
+        m_maxCount = qMax(1, count);
+        trim();
+    }
+
+    /// The kept activities, newest first
+    Activity::List activities() const { return m_activities; }
+
+    /// The timestamp of the newest activity seen so far
+    QDateTime newestTimestamp() const
+    {
+        return m_activities.isEmpty() ? QDateTime() : m_activities.first().timestamp();
+    }
+
+    QString newestId() const
+    {
+        return m_activities.isEmpty() ? QString() : m_activities.first().id();
+    }
+
+    void refresh()
+    {
+        if (m_refreshing) {
+            return;
+        }
+        m_refreshing = true;
+        ListJob<Activity> *job = m_provider.requestActivities();
+        connect(job, &BaseJob::finished, this, [this](BaseJob *baseJob) {
+            m_refreshing = false;
+            if (baseJob->metadata().error() != Metadata::NoError) {
+                emit refreshFailed(baseJob->metadata());
+                return;
+            }
+            merge(static_cast<ListJob<Activity> *>(baseJob)->itemList());
+        });
+        job->start();
+    }
+
+Q_SIGNALS:
+    /// Activities that were not in the feed before, newest first
+    void activitiesAdded(const Attica::Activity::List &activities);
+    void refreshFailed(const Attica::Metadata &metadata);
+
+private:
+    static bool newerThan(const Activity &a, const Activity &b)
+    {
+        return a.timestamp() > b.timestamp();
+    }
+
+    void merge(const Activity::List &activities)
+    {
+        const bool full = m_activities.size() >= m_maxCount;
+        const QDateTime oldest = m_activities.isEmpty() ? QDateTime() : m_activities.last().timestamp();
+
+        Activity::List added;
+        for (const Activity &activity : activities) {
+            if (m_ids.contains(activity.id()) || (full && activity.timestamp() <= oldest)) {
+                continue;
+            }
+            m_ids.insert(activity.id());
+            added.append(m_persons->intern(activity));
+        }
+        if (added.isEmpty()) {
+            return;
+        }
+
+        std::sort(added.begin(), added.end(), &ActivityFeed::newerThan);
+        Activity::List merged;
+        merged.reserve(m_activities.size() + added.size());
+        std::merge(added.constBegin(), added.constEnd(), m_activities.constBegin(), m_activities.constEnd(),
+                   std::back_inserter(merged), &ActivityFeed::newerThan);
+        m_activities = merged;
+        trim();
+        emit activitiesAdded(added);
+    }
+
+    void trim()
+    {
+        while (m_activities.size() > m_maxCount) {
+            m_ids.remove(m_activities.takeLast().id());
+        }
+    }
+
+    Provider m_provider;
+    PersonRegistry *m_persons;
+    Activity::List m_activities;
+    QSet<QString> m_ids;
+    int m_maxCount;
+    bool m_refreshing;
+};
+
+}
+
+#endif
@@ -0,0 +1,318 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_BUILDJOBMONITOR_H
+#define ATTICA_BUILDJOBMONITOR_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+#include "buildservicejob.h"
+#include "project.h"
+#include "provider.h"
+
+namespace Attica
+{
+
+/**
+ * Watches the status of many build service jobs with few requests.
+ *
+ * Jobs of the same project are polled together with one
+ * Provider::requestBuildServiceJobs() call; only jobs without a project id
+ * are polled one by one. That listing is not paged, so a job that is
+ * missing from it twice in a row is polled on its own from then on.
+ *
+ * Each job has its own interval: it starts at minimumInterval(), grows with
+ * every poll that brings no change, and is kept short for running jobs that
+ * are close to completion. A project is polled as often as its most urgent
+ * job needs.
+ *
+ * statusChanged() is only emitted when a job moves between pending,
+ * running, completed and failed. Completed and failed jobs are reported
+ * through jobFinished() and no longer polled. A job polled on its own that
+ * the server fails to report five times in a row, for example because it
+ * was deleted, is dropped and reported through jobLost(); network errors do
+ * not count towards that.
+ */
+class BuildJobMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BuildJobMonitor(const Provider &provider, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_minimumInterval(5000)
+        , m_maximumInterval(300000)
+    {
+        m_timer.setSingleShot(true);
+        connect(&m_timer, &QTimer::timeout, this, &BuildJobMonitor::pollDue);
+    }
+
+    int minimumInterval() const { return m_minimumInterval; }
+    int maximumInterval() const { return m_maximumInterval; }
+
+    /// Bounds for the poll interval of a job in milliseconds, 5 seconds to 5 minutes by default
+    void setIntervals(int minimum, int maximum)
+    {
+        m_minimumInterval = qMax(100, minimum);
+        m_maximumInterval = qMax(m_minimumInterval, maximum);
+    }
+
+    void watch(const BuildServiceJob &job)
+    {
+        if (isDone(job)) {
+            return;
+        }
+        Watched &watched = m_jobs[job.id()];
+        watched.job = job;
+        watched.interval = m_minimumInterval;
+        watched.due = QDateTime::currentMSecsSinceEpoch() + m_minimumInterval;
+        schedule();
+    }
+
+    void unwatch(const QString &jobId)
+    {
+        m_jobs.remove(jobId);
+        schedule();
+    }
+
+    int count() const { return m_jobs.size(); }
+
+Q_SIGNALS:
+    void statusChanged(const Attica::BuildServiceJob &job);
+    void jobFinished(const Attica::BuildServiceJob &job);
+    /// @p job is no longer watched because polling it kept failing, @p metadata is from the last poll
+    void jobLost(const Attica::BuildServiceJob &job, const Attica::Metadata &metadata);
+
+private:
+    enum State { Pending, Running, Completed, Failed };
+
+    // project listings a job may be missing from before it is polled on its own
+    enum { MaxMisses = 2 };
+    // failed polls in a row after which a job polled on its own is dropped
+    enum { MaxFailures = 5 };
+
+    struct Watched {
+        Watched() : interval(0), due(0), misses(0), failures(0), single(false) {}
+        BuildServiceJob job;
+        qint64 interval;
+        qint64 due;
+        int misses;
+        int failures;
+        bool single;
+    };
+
+    static State state(const BuildServiceJob &job)
+    {
+        if (job.isFailed()) {
+            return Failed;
+        }
+        if (job.isCompleted()) {
+            return Completed;
+        }
+        return job.isRunning() ? Running : Pending;
+    }
+
+    static bool isDone(const BuildServiceJob &job)
+    {
+        const State s = state(job);
+        return s == Completed || s == Failed;
+    }
+
+    void schedule()
+    {
+        if (m_jobs.isEmpty()) {
+            m_timer.stop();
+            return;
+        }
+        qint64 next = -1;
+        for (QHash<QString, Watched>::const_iterator it = m_jobs.constBegin(); it != m_jobs.constEnd(); ++it) {
+            if (!m_polling.contains(pollKey(*it)) && (next < 0 || it->due < next)) {
+                next = it->due;
+            }
+        }
+        if (next < 0) {
+            return;
+        }
+        m_timer.start(int(qBound(qint64(0), next - QDateTime::currentMSecsSinceEpoch(), qint64(m_maximumInterval))));
+    }
+
+    // jobs sharing a key are polled with one request
+    static QString pollKey(const Watched &watched)
+    {
+        const BuildServiceJob &job = watched.job;
+        return watched.single || job.projectId().isEmpty() ? QStringLiteral("job:") + job.id() : QStringLiteral("project:") + job.projectId();
+    }
+
+    void pollDue()
+    {
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        QSet<QString> keys;
+        for (QHash<QString, Watched>::const_iterator it = m_jobs.constBegin(); it != m_jobs.constEnd(); ++it) {
+            if (it->due <= now) {
+                keys.insert(pollKey(*it));
+            }
+        }
+        for (const QString &key : qAsConst(keys)) {
+            if (m_polling.contains(key)) {
+                continue;
+            }
+            m_polling.insert(key);
+            const QString id = key.mid(key.indexOf(QLatin1Char(':')) + 1);
+            BaseJob *job;
+            if (key.startsWith(QLatin1String("project:"))) {
+                Project project;
+                project.setId(id);
+                ListJob<BuildServiceJob> *listJob = m_provider.requestBuildServiceJobs(project);
+                connect(listJob, &BaseJob::finished, this, [this, key](BaseJob *baseJob) {
+                    polled(key, baseJob, static_cast<ListJob<BuildServiceJob> *>(baseJob)->itemList());
+                });
+                job = listJob;
+            } else {
+                ItemJob<BuildServiceJob> *itemJob = m_provider.requestBuildServiceJob(id);
+                connect(itemJob, &BaseJob::finished, this, [this, key](BaseJob *baseJob) {
+                    polled(key, baseJob, BuildServiceJob::List() << static_cast<ItemJob<BuildServiceJob> *>(baseJob)->result());
+                });
+                job = itemJob;
+            }
+            job->start();
+        }
+        schedule();
+    }
+
+    void polled(const QString &key, BaseJob *baseJob, const BuildServiceJob::List &results)
+    {
+        m_polling.remove(key);
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        const Metadata metadata = baseJob->metadata();
+        const bool ok = metadata.error() == Metadata::NoError;
+        const bool single = key.startsWith(QLatin1String("job:"));
+
+        BuildServiceJob::List changedJobs;
+        BuildServiceJob::List finishedJobs;
+        BuildServiceJob::List lostJobs;
+        QHash<QString, BuildServiceJob> byId;
+        if (ok) {
+            for (const BuildServiceJob &result : results) {
+                byId.insert(result.id(), result);
+            }
+        }
+
+        for (QHash<QString, Watched>::iterator it = m_jobs.begin(); it != m_jobs.end();) {
+            if (pollKey(*it) != key) {
+                ++it;
+                continue;
+            }
+            QHash<QString, BuildServiceJob>::const_iterator result = byId.constFind(it.key());
+            if (result == byId.constEnd()) {
+                if (single && metadata.error() != Metadata::NetworkError && ++it->failures >= MaxFailures) {
+                    // the server answers but keeps not knowing the job
+                    lostJobs.append(it->job);
+                    it = m_jobs.erase(it);
+                    continue;
+                }
+                if (!single && ok && ++it->misses >= MaxMisses) {
+                    // the project has more jobs than its listing shows
+                    it->single = true;
+                    it->due = now;
+                } else {
+                    // keep the job but back off, the server may just not list it yet
+                    it->interval = qMin(it->interval * 2, qint64(m_maximumInterval));
+                    it->due = now + it->interval;
+                }
+                ++it;
+                continue;
+            }
+            it->misses = 0;
+            it->failures = 0;
+
+            const bool changed = state(*result) != state(it->job);
+            it->job = *result;
+            if (changed) {
+                changedJobs.append(*result);
+            }
+            if (isDone(*result)) {
+                finishedJobs.append(*result);
+                it = m_jobs.erase(it);
+                continue;
+            }
+            it->interval = nextInterval(it->interval, changed, *result);
+            it->due = now + it->interval;
+            ++it;
+        }
+
+        // jobs of one project are polled together, so align them to the most urgent one
+        qint64 due = -1;
+        for (QHash<QString, Watched>::const_iterator it = m_jobs.constBegin(); it != m_jobs.constEnd(); ++it) {
+            if (pollKey(*it) == key && (due < 0 || it->due < due)) {
+                due = it->due;
+            }
+        }
+        for (QHash<QString, Watched>::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it) {
+            if (pollKey(*it) == key) {
+                it->due = due;
+            }
+        }
+        schedule();
+
+        // emitted last, receivers may watch or unwatch jobs
+        for (const BuildServiceJob &job : qAsConst(changedJobs)) {
+            emit statusChanged(job);
+        }
+        for (const BuildServiceJob &job : qAsConst(finishedJobs)) {
+            emit jobFinished(job);
+        }
+        for (const BuildServiceJob &job : qAsConst(lostJobs)) {
+            emit jobLost(job, metadata);
+        }
+    }
+
+    qint64 nextInterval(qint64 interval, bool changed, const BuildServiceJob &job) const
+    {
+        if (changed) {
+            return m_minimumInterval;
+        }
+        qint64 next = qMin(interval + interval / 2, qint64(m_maximumInterval));
+        // servers report progress either as a fraction or as a percentage
+        const qreal progress = job.progress() > 1.0 ? job.progress() / 100.0 : job.progress();
+        if (job.isRunning() && progress >= 0.9) {
+            next = qMin(next, qint64(m_minimumInterval) * 2);
+        }
+        return next;
+    }
+
+    Provider m_provider;
+    QTimer m_timer;
+    QHash<QString, Watched> m_jobs;
+    QSet<QString> m_polling;
+    int m_minimumInterval;
+    int m_maximumInterval;
+};
+
+}
+
+#endif
@@ -0,0 +1,395 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_CONTENTMIRROR_H
+#define ATTICA_CONTENTMIRROR_H
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+
+#include <algorithm>
+
+#include "content.h"
+#include "provider.h"
+
+namespace Attica
+{
+
+/**
+ * A persistent local copy of the Content catalog of one Provider.
+ *
+ * sync() walks searchContents() sorted by Provider::Newest page by page and
+ * stores every item that is new or whose updated() date changed. It stops at
+ * the first page that only brings items the mirror already knows and that
+ * are older than the watermark of the previous sync of the same categories
+ * (each set of categories keeps its own watermark), so a sync after a short
+ * while costs a single request.
+ *
+ * The store is a compact binary file that is written after every sync and
+ * read back with load(). Lookups and queries are answered from memory.
+ */
+class ContentMirror : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @param provider the provider to mirror
+     * @param fileName where the mirror is stored, by default a file in QStandardPaths::CacheLocation
+     */
+    explicit ContentMirror(const Provider &provider, const QString &fileName = QString(), QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_fileName(fileName.isEmpty() ? defaultFileName(provider) : fileName)
+        , m_pageSize(100)
+        , m_page(0)
+        , m_received(0)
+        , m_changed(0)
+        , m_syncing(false)
+    {
+    }
+
+    /// Reads the mirror from disk, replacing what is in memory
+    bool load()
+    {
+        QFile file(m_fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_6);
+        quint32 magic;
+        quint32 version;
+        stream >> magic >> version;
+        if (magic != Magic || version != Version) {
+            return false;
+        }
+        QHash<QString, QDateTime> watermarks;
+        qint32 count;
+        stream >> watermarks >> count;
+        QHash<QString, Entry> entries;
+        entries.reserve(count);
+        for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+            Entry entry;
+            stream >> entry.fetched;
+            entry.content = readContent(stream);
+            entries.insert(entry.content.id(), entry);
+        }
+        if (stream.status() != QDataStream::Ok) {
+            return false;
+        }
+        m_watermarks = watermarks;
+        m_entries = entries;
+        return true;
+    }
+
+    /// Writes the mirror to disk
+    bool save() const
+    {
+        QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+        QSaveFile file(m_fileName);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_6);
+        stream << quint32(Magic) << quint32(Version) << m_watermarks << qint32(m_entries.size());
+        for (QHash<QString, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            stream << it->fetched;
+            writeContent(stream, it->content);
+        }
+        return stream.status() == QDataStream::Ok && file.commit();
+    }
+
+    /**
+     * Fetches everything that changed since the last sync.
+     * Emits contentChanged() for each new or updated item and synced() at the end.
+     */
+    void sync(const Category::List &categories, uint pageSize = 100)
+    {
+        if (m_syncing) {
+            return;
+        }
+        m_syncing = true;
+        m_categories = categories;
+        m_pageSize = pageSize;
+        m_page = 0;
+        m_received = 0;
+        m_changed = 0;
+        m_watermarkKey = categoriesKey(categories);
+        m_watermark = m_watermarks.value(m_watermarkKey);
+        m_newestSeen = m_watermark;
+        requestPage();
+    }
+
+    bool isSyncing() const { return m_syncing; }
+
+    /// The newest updated() date seen by the last completed sync of @p categories
+    QDateTime watermark(const Category::List &categories) const
+    {
+        return m_watermarks.value(categoriesKey(categories));
+    }
+
+    int count() const { return m_entries.size(); }
+    bool contains(const QString &id) const { return m_entries.contains(id); }
+
+    Content content(const QString &id) const
+    {
+        return m_entries.value(id).content;
+    }
+
+    /// When the stored copy of @p id was fetched from the server
+    QDateTime fetched(const QString &id) const
+    {
+        return m_entries.value(id).fetched;
+    }
+
+    /**
+     * All stored items accepted by @p filter, sorted like the server would sort them.
+     * @param limit the maximum number of items, or -1 for all
+     */
+    template <class Filter>
+    Content::List query(Filter filter, Provider::SortMode mode = Provider::Rating, int limit = -1) const
+    {
+        Content::List result;
+        for (QHash<QString, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            if (filter(it->content)) {
+                result.append(it->content);
+            }
+        }
+        std::sort(result.begin(), result.end(), [mode](const Content &a, const Content &b) {
+            switch (mode) {
+            case Provider::Newest:
+                return a.updated() > b.updated();
+            case Provider::Alphabetical:
+                return a.name().compare(b.name(), Qt::CaseInsensitive) < 0;
+            case Provider::Downloads:
+                return a.downloads() > b.downloads();
+            case Provider::Rating:
+            default:
+                return a.rating() > b.rating();
+            }
+        });
+        if (limit >= 0 && result.size() > limit) {
+            result.erase(result.begin() + limit, result.end());
+        }
+        return result;
+    }
+
+    /**
+     * Emits contentAvailable() for @p id, straight from the mirror if the stored
+     * copy is at most @p maxAge seconds old, otherwise after fetching it with
+     * Provider::requestContent().
+     */
+    void requestContent(const QString &id, qint64 maxAge)
+    {
+        QHash<QString, Entry>::const_iterator it = m_entries.constFind(id);
+        if (it != m_entries.constEnd() && it->fetched.secsTo(QDateTime::currentDateTimeUtc()) <= maxAge) {
+            emit contentAvailable(it->content);
+            return;
+        }
+        ItemJob<Content> *job = m_provider.requestContent(id);
+        connect(job, &BaseJob::finished, this, [this](BaseJob *baseJob) {
+            if (baseJob->metadata().error() != Metadata::NoError) {
+                emit requestFailed(baseJob->metadata());
+                return;
+            }
+            const Content content = static_cast<ItemJob<Content> *>(baseJob)->result();
+            store(content);
+            emit contentAvailable(content);
+        });
+        job->start();
+    }
+
+Q_SIGNALS:
+    void contentAvailable(const Attica::Content &content);
+    /// A new item or a new version of a known item was stored during sync()
+    void contentChanged(const Attica::Content &content);
+    /// sync() completed, @p changed items were added or updated
+    void synced(int changed);
+    void requestFailed(const Attica::Metadata &metadata);
+
+private:
+    enum { Magic = 0x4174436d, Version = 2 };
+
+    struct Entry {
+        Content content;
+        QDateTime fetched;
+    };
+
+    static QString defaultFileName(const Provider &provider)
+    {
+        const QByteArray key = QCryptographicHash::hash(provider.baseUrl().toEncoded(), QCryptographicHash::Sha1).toHex();
+        return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+               + QStringLiteral("/attica/mirror/") + QString::fromLatin1(key) + QStringLiteral(".dat");
+    }
+
+    static QString categoriesKey(const Category::List &categories)
+    {
+        QStringList ids;
+        for (const Category &category : categories) {
+            ids.append(category.id());
+        }
+        ids.sort();
+        ids.removeDuplicates();
+        return ids.join(QLatin1Char(','));
+    }
+
+    void requestPage()
+    {
+        ListJob<Content> *job = m_provider.searchContents(m_categories, QString(), Provider::Newest, m_page, m_pageSize);
+        connect(job, &BaseJob::finished, this, &ContentMirror::pageFinished);
+        job->start();
+    }
+
+    void pageFinished(BaseJob *baseJob)
+    {
+        Metadata metadata = baseJob->metadata();
+        if (metadata.error() != Metadata::NoError) {
+            m_syncing = false;
+            emit requestFailed(metadata);
+            return;
+        }
+
+        const Content::List items = static_cast<ListJob<Content> *>(baseJob)->itemList();
+        m_received += items.size();
+        bool reachedKnown = false;
+        for (const Content &item : items) {
+            QHash<QString, Entry>::const_iterator known = m_entries.constFind(item.id());
+            const bool unchanged = known != m_entries.constEnd() && known->content.updated() >= item.updated();
+            if (item.updated() > m_newestSeen) {
+                m_newestSeen = item.updated();
+            }
+            if (unchanged) {
+                reachedKnown = reachedKnown || (m_watermark.isValid() && item.updated() <= m_watermark);
+                continue;
+            }
+            store(item);
+            ++m_changed;
+            emit contentChanged(item);
+        }
+
+        // servers may cap the page size, so only the total tells when the catalog was walked completely
+        const int total = metadata.totalItems();
+        const bool complete = items.isEmpty() || (total > 0 && m_received >= total);
+        if (reachedKnown || complete) {
+            m_watermarks.insert(m_watermarkKey, m_newestSeen);
+            m_syncing = false;
+            save();
+            emit synced(m_changed);
+            return;
+        }
+        ++m_page;
+        requestPage();
+    }
+
+    void store(const Content &content)
+    {
+        Entry &entry = m_entries[content.id()];
+        entry.content = content;
+        entry.fetched = QDateTime::currentDateTimeUtc();
+    }
+
+    static void writeContent(QDataStream &stream, Content content)
+    {
+        QList<QUrl> iconUrls;
+        QList<QPair<uint, uint> > iconSizes;
+        const QList<Icon> icons = content.icons();
+        for (const Icon &icon : icons) {
+            iconUrls.append(icon.url());
+            iconSizes.append(qMakePair(icon.width(), icon.height()));
+        }
+        stream << content.id() << content.name() << qint32(content.rating()) << qint32(content.downloads())
+               << qint32(content.numberOfComments()) << content.created() << content.updated() << content.tags()
+               << content.attributes() << iconUrls << iconSizes << content.videos();
+    }
+
+    static Content readContent(QDataStream &stream)
+    {
+        QString id;
+        QString name;
+        qint32 rating;
+        qint32 downloads;
+        qint32 comments;
+        QDateTime created;
+        QDateTime updated;
+        QStringList tags;
+        QMap<QString, QString> attributes;
+        QList<QUrl> iconUrls;
+        QList<QPair<uint, uint> > iconSizes;
+        QList<QUrl> videos;
+        stream >> id >> name >> rating >> downloads >> comments >> created >> updated >> tags
+               >> attributes >> iconUrls >> iconSizes >> videos;
+
+        Content content;
+        content.setId(id);
+        content.setName(name);
+        content.setRating(rating);
+        content.setDownloads(downloads);
+        content.setNumberOfComments(comments);
+        content.setCreated(created);
+        content.setUpdated(updated);
+        content.setTags(tags);
+        for (QMap<QString, QString>::const_iterator it = attributes.constBegin(); it != attributes.constEnd(); ++it) {
+            content.addAttribute(it.key(), it.value());
+        }
+        QList<Icon> icons;
+        for (int i = 0; i < iconUrls.size() && i < iconSizes.size(); ++i) {
+            Icon icon;
+            icon.setUrl(iconUrls.at(i));
+            icon.setWidth(iconSizes.at(i).first);
+            icon.setHeight(iconSizes.at(i).second);
+            icons.append(icon);
+        }
+        content.setIcons(icons);
+        content.setVideos(videos);
+        return content;
+    }
+
+    Provider m_provider;
+    const QString m_fileName;
+    QHash<QString, Entry> m_entries;
+    QHash<QString, QDateTime> m_watermarks;
+    QString m_watermarkKey;
+    QDateTime m_watermark;
+    QDateTime m_newestSeen;
+    Category::List m_categories;
+    uint m_pageSize;
+    uint m_page;
+    int m_received;
+    int m_changed;
+    bool m_syncing;
+};
+
+}
+
+#endif
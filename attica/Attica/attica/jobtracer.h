@@ -0,0 +1,185 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_JOBTRACER_H
+#define ATTICA_JOBTRACER_H
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QString>
+#include <QThread>
+
+namespace Attica
+{
+
+/**
+ * Receives lifecycle events of Attica jobs and of a ProviderManager.
+ *
+ * Install an implementation with JobStatsRecorder::setTracer(). traceEvent()
+ * is called on the thread the event happened on, so implementations have to
+ * be thread safe.
+ */
+class JobTracer
+{
+public:
+    enum Event {
+        JobCreated,
+        JobStarted,
+        JobFinished,
+        JobDeleted,
+        ProviderAdded,
+        DefaultProvidersLoaded,
+        ProviderFailedToLoad
+    };
+
+    virtual ~JobTracer() {}
+
+    /**
+     * @param event what happened
+     * @param id identifies the job across its events, 0 for manager events
+     * @param name the endpoint of the job or the url of the provider
+     * @param timestamp monotonic microseconds, @see JobStats::now()
+     * @param thread the thread the event happened on
+     */
+    virtual void traceEvent(Event event, quintptr id, const QString &name, qint64 timestamp, quintptr thread) = 0;
+
+    static quintptr currentThread()
+    {
+        return quintptr(QThread::currentThreadId());
+    }
+};
+
+/**
+ * A JobTracer that collects the events in the Chrome trace event format,
+ * which can be loaded into chrome://tracing or the Perfetto UI.
+ *
+ * Every job becomes an async slice from creation to deletion, with nested
+ * "queued" and "running" slices; manager events become instant events.
+ */
+class ChromeTraceWriter : public JobTracer
+{
+public:
+    ChromeTraceWriter()
+        : m_pid(QCoreApplication::applicationPid())
+    {
+    }
+
+    void traceEvent(Event event, quintptr id, const QString &name, qint64 timestamp, quintptr thread) override
+    {
+        QMutexLocker locker(&m_mutex);
+        switch (event) {
+        case JobCreated:
+            append("b", name, id, timestamp, thread);
+            append("b", QStringLiteral("queued"), id, timestamp, thread);
+            break;
+        case JobStarted:
+            m_started.insert(id);
+            append("e", QStringLiteral("queued"), id, timestamp, thread);
+            append("b", QStringLiteral("running"), id, timestamp, thread);
+            break;
+        case JobFinished:
+            append("e", m_started.remove(id) ? QStringLiteral("running") : QStringLiteral("queued"), id, timestamp, thread);
+            break;
+        case JobDeleted:
+            append("e", name, id, timestamp, thread);
+            break;
+        case ProviderAdded:
+            appendInstant(QStringLiteral("providerAdded ") + name, timestamp, thread);
+            break;
+        case DefaultProvidersLoaded:
+            appendInstant(QStringLiteral("defaultProvidersLoaded"), timestamp, thread);
+            break;
+        case ProviderFailedToLoad:
+            appendInstant(QStringLiteral("failedToLoad ") + name, timestamp, thread);
+            break;
+        }
+    }
+
+    /// The collected trace as a JSON document
+    QByteArray toJson() const
+    {
+        QMutexLocker locker(&m_mutex);
+        QJsonObject trace;
+        trace.insert(QStringLiteral("traceEvents"), m_events);
+        trace.insert(QStringLiteral("displayTimeUnit"), QStringLiteral("ms"));
+        return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+    }
+
+    /// Writes the collected trace to @p fileName
+    bool save(const QString &fileName) const
+    {
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return false;
+        }
+        return file.write(toJson()) != -1;
+    }
+
+    void clear()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_events = QJsonArray();
+        m_started.clear();
+    }
+
+private:
+    QJsonObject event(const char *phase, const QString &name, qint64 timestamp, quintptr thread) const
+    {
+        QJsonObject object;
+        object.insert(QStringLiteral("ph"), QLatin1String(phase));
+        object.insert(QStringLiteral("cat"), QStringLiteral("attica"));
+        object.insert(QStringLiteral("name"), name);
+        object.insert(QStringLiteral("ts"), double(timestamp));
+        object.insert(QStringLiteral("pid"), double(m_pid));
+        object.insert(QStringLiteral("tid"), double(thread));
+        return object;
+    }
+
+    void append(const char *phase, const QString &name, quintptr id, qint64 timestamp, quintptr thread)
+    {
+        QJsonObject object = event(phase, name, timestamp, thread);
+        object.insert(QStringLiteral("id"), QStringLiteral("0x") + QString::number(id, 16));
+        m_events.append(object);
+    }
+
+    void appendInstant(const QString &name, qint64 timestamp, quintptr thread)
+    {
+        QJsonObject object = event("i", name, timestamp, thread);
+        object.insert(QStringLiteral("s"), QStringLiteral("p"));
+        m_events.append(object);
+    }
+
+    const qint64 m_pid;
+    mutable QMutex m_mutex;
+    QJsonArray m_events;
+    QSet<quintptr> m_started;
+};
+
+}
+
+#endif
@@ -0,0 +1,221 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_PERSONREGISTRY_H
+#define ATTICA_PERSONREGISTRY_H
+
+#include <QCache>
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QStringList>
+#include <QUrl>
+
+#include "activity.h"
+#include "person.h"
+#include "provider.h"
+#include "sharedinstances.h"
+
+namespace Attica
+{
+
+/**
+ * Shares one Person instance per user id of a Provider.
+ *
+ * Person is implicitly shared, so handing out copies of the instance kept
+ * here makes every occurrence of a user in activity feeds, friend lists and
+ * comments point to the same data instead of a parsed copy each.
+ *
+ * The persons embedded in activities or comments only carry a few fields,
+ * so interned persons count as incomplete. resolve() turns user ids into
+ * complete Person objects, requesting at most maxConcurrentRequests() of
+ * them from the server at the same time and skipping those that are
+ * complete already (fetched or passed to store()) or on their way.
+ *
+ * At most maxCount() persons are kept; the least recently used ones are
+ * dropped first. Copies handed out stay valid, a dropped person is just no
+ * longer shared with later occurrences.
+ *
+ * Like all shared instances, the registry is bound to one thread; see
+ * SharedInstances.
+ */
+class PersonRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// The registry shared by all copies of @p provider, see SharedInstances
+    static PersonRegistry *forProvider(const Provider &provider)
+    {
+        return SharedInstances<PersonRegistry>::instance(provider.baseUrl(), [&](QObject *parent) {
+            return new PersonRegistry(provider, parent);
+        });
+    }
+
+    explicit PersonRegistry(const Provider &provider, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_persons(10000)
+        , m_maxConcurrentRequests(4)
+        , m_running(0)
+    {
+    }
+
+    /// The number of persons kept at most, 10000 by default
+    int maxCount() const { return m_persons.maxCost(); }
+    void setMaxCount(int count) { m_persons.setMaxCost(count); }
+
+    int maxConcurrentRequests() const { return m_maxConcurrentRequests; }
+    void setMaxConcurrentRequests(int count) { m_maxConcurrentRequests = qMax(1, count); }
+
+    /**
+     * The shared instance for the id of @p person.
+     * The first Person seen for an id is kept; use store() to replace it.
+     */
+    Person intern(const Person &person)
+    {
+        if (person.id().isEmpty()) {
+            return person;
+        }
+        if (const Entry *entry = m_persons.object(person.id())) {
+            return entry->person;
+        }
+        m_persons.insert(person.id(), new Entry(person, false));
+        return person;
+    }
+
+    Person::List intern(const Person::List &persons)
+    {
+        Person::List result;
+        result.reserve(persons.size());
+        for (const Person &person : persons) {
+            result.append(intern(person));
+        }
+        return result;
+    }
+
+    /// @p activity with its associated person replaced by the shared instance
+    Activity intern(const Activity &activity)
+    {
+        Activity result(activity);
+        result.setAssociatedPerson(intern(activity.associatedPerson()));
+        return result;
+    }
+
+    Activity::List intern(const Activity::List &activities)
+    {
+        Activity::List result;
+        result.reserve(activities.size());
+        for (const Activity &activity : activities) {
+            result.append(intern(activity));
+        }
+        return result;
+    }
+
+    /// Replaces the shared instance for the id of @p person with the complete profile
+    void store(const Person &person)
+    {
+        if (!person.id().isEmpty()) {
+            m_persons.insert(person.id(), new Entry(person, true));
+        }
+    }
+
+    bool contains(const QString &id) const { return m_persons.contains(id); }
+
+    /// Whether the complete profile of @p id is known, not just what an activity carried
+    bool isComplete(const QString &id) const
+    {
+        const Entry *entry = m_persons.object(id);
+        return entry && entry->complete;
+    }
+
+    Person person(const QString &id) const
+    {
+        const Entry *entry = m_persons.object(id);
+        return entry ? entry->person : Person();
+    }
+
+    /**
+     * Requests all of @p ids whose complete profile is not known yet.
+     * personResolved() is emitted for every id, right away for complete ones.
+     */
+    void resolve(const QStringList &ids)
+    {
+        for (const QString &id : ids) {
+            const Entry *entry = m_persons.object(id);
+            if (entry && entry->complete) {
+                emit personResolved(entry->person);
+            } else if (!m_requested.contains(id)) {
+                m_requested.insert(id);
+                m_queue.enqueue(id);
+            }
+        }
+        startRequests();
+    }
+
+Q_SIGNALS:
+    void personResolved(const Attica::Person &person);
+    void resolveFailed(const QString &id, const Attica::Metadata &metadata);
+
+private:
+    struct Entry {
+        Entry(const Person &person, bool complete) : person(person), complete(complete) {}
+        Person person;
+        bool complete;
+    };
+
+    void startRequests()
+    {
+        while (m_running < m_maxConcurrentRequests && !m_queue.isEmpty()) {
+            const QString id = m_queue.dequeue();
+            ItemJob<Person> *job = m_provider.requestPerson(id);
+            ++m_running;
+            connect(job, &BaseJob::finished, this, [this, id](BaseJob *baseJob) {
+                --m_running;
+                m_requested.remove(id);
+                if (baseJob->metadata().error() == Metadata::NoError) {
+                    Person person = static_cast<ItemJob<Person> *>(baseJob)->result();
+                    if (person.id().isEmpty()) {
+                        person.setId(id);
+                    }
+                    store(person);
+                    emit personResolved(person);
+                } else {
+                    emit resolveFailed(id, baseJob->metadata());
+                }
+                startRequests();
+            });
+            job->start();
+        }
+    }
+
+    Provider m_provider;
+    QCache<QString, Entry> m_persons;
+    QSet<QString> m_requested;
+    QQueue<QString> m_queue;
+    int m_maxConcurrentRequests;
+    int m_running;
+};
+
+}
+
+#endif
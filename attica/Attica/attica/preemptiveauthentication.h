@@ -0,0 +1,144 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_PREEMPTIVEAUTHENTICATION_H
+#define ATTICA_PREEMPTIVEAUTHENTICATION_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+#include <QVariant>
+
+#include "atticabasejob.h"
+
+namespace Attica
+{
+
+/**
+ * Adds an Authorization header to @p request before it is sent, which saves
+ * the round trip for the 401 challenge.
+ *
+ * A non-empty @p bearerToken is sent as a bearer token. Otherwise the user
+ * name and password that Provider::createRequest() stores in the
+ * BaseJob::UserAttribute and BaseJob::PasswordAttribute of the request are
+ * sent as Basic credentials.
+ * @return whether a header was added
+ */
+inline bool addPreemptiveAuthorization(QNetworkRequest &request, const QByteArray &bearerToken = QByteArray())
+{
+    if (request.hasRawHeader("Authorization")) {
+        return false;
+    }
+    if (!bearerToken.isEmpty()) {
+        request.setRawHeader("Authorization", "Bearer " + bearerToken);
+        return true;
+    }
+    const QString user = request.attribute(QNetworkRequest::Attribute(BaseJob::UserAttribute)).toString();
+    if (user.isEmpty()) {
+        return false;
+    }
+    const QString password = request.attribute(QNetworkRequest::Attribute(BaseJob::PasswordAttribute)).toString();
+    request.setRawHeader("Authorization", "Basic " + (user + QLatin1Char(':') + password).toUtf8().toBase64());
+    return true;
+}
+
+/**
+ * A QNetworkAccessManager that authenticates preemptively.
+ *
+ * PlatformDependent implementations can hand this out from nam() so that
+ * all requests of a Provider with known credentials carry them from the
+ * start. If a server still answers 401, preemptive authentication is turned
+ * off for that host and the regular challenge path through
+ * BaseJob::authenticationRequired() takes over. It is turned on again once
+ * an authenticated request to the host succeeds, or when the credentials
+ * for the host change.
+ */
+class PreemptiveAuthNetworkAccessManager : public QNetworkAccessManager
+{
+public:
+    explicit PreemptiveAuthNetworkAccessManager(QObject *parent = nullptr)
+        : QNetworkAccessManager(parent)
+    {
+        // remember which replies went through the challenge path, so that
+        // only those count as authenticated when they succeed
+        connect(this, &QNetworkAccessManager::authenticationRequired, this, [](QNetworkReply *reply) {
+            reply->setProperty("atticaChallenged", true);
+        });
+    }
+
+    /// Send @p token as bearer token to @p host in place of the user name and password
+    void setBearerToken(const QString &host, const QByteArray &token)
+    {
+        if (token.isEmpty()) {
+            m_tokens.remove(host);
+        } else {
+            m_tokens.insert(host, token);
+        }
+    }
+
+protected:
+    QNetworkReply *createRequest(Operation op, const QNetworkRequest &originalRequest, QIODevice *outgoingData = nullptr) override
+    {
+        const QString host = originalRequest.url().host();
+        QNetworkRequest request(originalRequest);
+        if (!addPreemptiveAuthorization(request, m_tokens.value(host))) {
+            return QNetworkAccessManager::createRequest(op, originalRequest, outgoingData);
+        }
+
+        const QByteArray authorization = request.rawHeader("Authorization");
+        const QHash<QString, QByteArray>::const_iterator rejected = m_rejected.constFind(host);
+        if (rejected != m_rejected.constEnd() && rejected.value() == authorization) {
+            // these credentials were turned down before; only clear the host
+            // once the challenge path got an authenticated reply through
+            QNetworkReply *reply = QNetworkAccessManager::createRequest(op, originalRequest, outgoingData);
+            connect(reply, &QNetworkReply::finished, this, [this, reply, host, authorization]() {
+                if (reply->error() == QNetworkReply::NoError && reply->property("atticaChallenged").toBool()
+                    && m_rejected.value(host) == authorization) {
+                    m_rejected.remove(host);
+                }
+            });
+            return reply;
+        }
+
+        QNetworkReply *reply = QNetworkAccessManager::createRequest(op, request, outgoingData);
+        connect(reply, &QNetworkReply::finished, this, [this, reply, host, authorization]() {
+            if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 401) {
+                m_rejected.insert(host, authorization);
+            } else if (reply->error() == QNetworkReply::NoError) {
+                m_rejected.remove(host);
+            }
+        });
+        return reply;
+    }
+
+private:
+    QHash<QString, QByteArray> m_tokens;
+    /// The Authorization header each host answered 401 to
+    QHash<QString, QByteArray> m_rejected;
+};
+
+}
+
+#endif
@@ -0,0 +1,430 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_PREVIEWCACHE_H
+#define ATTICA_PREVIEWCACHE_H
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QPair>
+#include <QPointer>
+#include <QSaveFile>
+#include <QSet>
+#include <QSize>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUrl>
+
+#include <algorithm>
+
+#include "icon.h"
+#include "provider.h"
+#include "sharedinstances.h"
+
+namespace Attica
+{
+
+/**
+ * Downloads and caches preview pictures, icons and avatars of a Provider.
+ *
+ * Images are stored on disk under the hash of their content, so the same
+ * picture behind several urls is kept once. When the size of all stored
+ * images exceeds maxSize(), the least recently used ones are removed.
+ *
+ * request() emits imageAvailable() right away for cached images. Other
+ * urls are queued; a url that is already queued or downloading is not
+ * fetched twice. Pending downloads start by priority, so rows that are on
+ * screen can overtake prefetched ones, and may be cancelled once they
+ * scroll away.
+ *
+ * Downloads use a private QNetworkAccessManager unless
+ * setNetworkAccessManager() is called; pass the one your PlatformDependent
+ * hands out from nam() so that its proxy and authentication setup applies.
+ */
+class PreviewCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority {
+        Prefetch,
+        Normal,
+        Visible
+    };
+
+    /// The cache for the images of @p provider, kept in QStandardPaths::CacheLocation; see SharedInstances
+    static PreviewCache *forProvider(const Provider &provider)
+    {
+        return SharedInstances<PreviewCache>::instance(provider.baseUrl(), [&](QObject *parent) {
+            const QByteArray key = QCryptographicHash::hash(provider.baseUrl().toEncoded(), QCryptographicHash::Sha1).toHex();
+            return new PreviewCache(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                                    + QStringLiteral("/attica/previews/") + QString::fromLatin1(key),
+                                    parent);
+        });
+    }
+
+    explicit PreviewCache(const QString &directory, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_directory(directory)
+        , m_maxSize(100 * 1024 * 1024)
+        , m_totalSize(0)
+        , m_maxConcurrentDownloads(6)
+        , m_running(0)
+    {
+        QDir().mkpath(m_directory);
+        loadIndex();
+        m_saveTimer.setSingleShot(true);
+        m_saveTimer.setInterval(2000);
+        connect(&m_saveTimer, &QTimer::timeout, this, &PreviewCache::saveIndex);
+    }
+
+    ~PreviewCache()
+    {
+        if (m_saveTimer.isActive()) {
+            saveIndex();
+        }
+    }
+
+    /// The manager used for downloads, the private one if none was set
+    QNetworkAccessManager *networkAccessManager()
+    {
+        return m_externalNam ? m_externalNam.data() : &m_nam;
+    }
+
+    /// Uses @p nam for downloads; it is not owned by the cache
+    void setNetworkAccessManager(QNetworkAccessManager *nam) { m_externalNam = nam; }
+
+    /// The size limit of the cache on disk in bytes, 100 MiB by default
+    qint64 maxSize() const { return m_maxSize; }
+    void setMaxSize(qint64 bytes)
+    {
+        m_maxSize = bytes;
+        evict();
+    }
+
+    qint64 size() const { return m_totalSize; }
+
+    int maxConcurrentDownloads() const { return m_maxConcurrentDownloads; }
+    void setMaxConcurrentDownloads(int count) { m_maxConcurrentDownloads = qMax(1, count); }
+
+    bool contains(const QUrl &url) const
+    {
+        return m_entries.contains(urlKey(url));
+    }
+
+    /// The file the image for @p url is stored in, or an empty string if it is not cached
+    QString cachedFile(const QUrl &url)
+    {
+        QHash<QByteArray, Entry>::iterator it = m_entries.find(urlKey(url));
+        if (it == m_entries.end()) {
+            return QString();
+        }
+        it->lastUsed = QDateTime::currentMSecsSinceEpoch();
+        m_saveTimer.start();
+        return blobFile(it->blob);
+    }
+
+    /// Emits imageAvailable() for @p url, after downloading it if it is not cached yet
+    void request(const QUrl &url, Priority priority = Normal)
+    {
+        if (!url.isValid()) {
+            return;
+        }
+        const QString file = cachedFile(url);
+        if (!file.isEmpty()) {
+            QFile blob(file);
+            if (blob.open(QIODevice::ReadOnly)) {
+                emit imageAvailable(url, blob.readAll());
+                return;
+            }
+            forget(urlKey(url));
+        }
+        ++m_requesters[url];
+        if (m_downloading.contains(url)) {
+            return;
+        }
+        QHash<QUrl, Priority>::iterator pending = m_pending.find(url);
+        if (pending != m_pending.end()) {
+            if (priority > *pending) {
+                m_queues[*pending].removeOne(url);
+                m_queues[priority].append(url);
+                *pending = priority;
+            }
+            return;
+        }
+        m_pending.insert(url, priority);
+        m_queues[priority].append(url);
+        startDownloads();
+    }
+
+    /// Changes the priority of a queued download, e.g. when its row scrolls into view
+    void setPriority(const QUrl &url, Priority priority)
+    {
+        QHash<QUrl, Priority>::iterator pending = m_pending.find(url);
+        if (pending != m_pending.end() && *pending != priority) {
+            m_queues[*pending].removeOne(url);
+            m_queues[priority].append(url);
+            *pending = priority;
+        }
+    }
+
+    /**
+     * Withdraws one request() for @p url. The queued download is dropped once
+     * every request for it was withdrawn, so other users of the cache still
+     * get the image; a download that started already is finished.
+     */
+    void cancel(const QUrl &url)
+    {
+        QHash<QUrl, int>::iterator requesters = m_requesters.find(url);
+        if (requesters == m_requesters.end()) {
+            return;
+        }
+        if (--*requesters > 0) {
+            return;
+        }
+        m_requesters.erase(requesters);
+        QHash<QUrl, Priority>::iterator pending = m_pending.find(url);
+        if (pending != m_pending.end()) {
+            m_queues[*pending].removeOne(url);
+            m_pending.erase(pending);
+        }
+    }
+
+    /**
+     * The icon that fits @p size best: the smallest one covering it, or the
+     * largest one if none does. Icons without size information are only
+     * picked if there is nothing else.
+     */
+    static Icon closestIcon(const QList<Icon> &icons, const QSize &size)
+    {
+        Icon best;
+        bool bestCovers = false;
+        for (const Icon &icon : icons) {
+            if (icon.width() == 0 || icon.height() == 0) {
+                if (best.url().isEmpty()) {
+                    best = icon;
+                }
+                continue;
+            }
+            const bool covers = int(icon.width()) >= size.width() && int(icon.height()) >= size.height();
+            const quint64 area = quint64(icon.width()) * icon.height();
+            const quint64 bestArea = quint64(best.width()) * best.height();
+            if (bestArea == 0
+                || (covers && (!bestCovers || area < bestArea))
+                || (!covers && !bestCovers && area > bestArea)) {
+                best = icon;
+                bestCovers = covers;
+            }
+        }
+        return best;
+    }
+
+Q_SIGNALS:
+    void imageAvailable(const QUrl &url, const QByteArray &data);
+    void imageFailed(const QUrl &url, QNetworkReply::NetworkError error);
+
+private:
+    struct Entry {
+        Entry() : size(0), lastUsed(0) {}
+        QByteArray blob;
+        qint64 size;
+        qint64 lastUsed;
+    };
+
+    enum { IndexVersion = 1 };
+
+    static QByteArray urlKey(const QUrl &url)
+    {
+        return QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1);
+    }
+
+    QString blobFile(const QByteArray &blob) const
+    {
+        return m_directory + QLatin1Char('/') + QString::fromLatin1(blob.toHex());
+    }
+
+    QString indexFile() const
+    {
+        return m_directory + QStringLiteral("/index");
+    }
+
+    void startDownloads()
+    {
+        while (m_running < m_maxConcurrentDownloads) {
+            QUrl url;
+            for (int priority = Visible; priority >= Prefetch && url.isEmpty(); --priority) {
+                if (!m_queues[priority].isEmpty()) {
+                    url = m_queues[priority].takeFirst();
+                }
+            }
+            if (url.isEmpty()) {
+                return;
+            }
+            m_pending.remove(url);
+            m_downloading.insert(url);
+            ++m_running;
+
+            QNetworkRequest request(url);
+            request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+            QNetworkReply *reply = networkAccessManager()->get(request);
+            connect(reply, &QNetworkReply::finished, this, [this, reply, url]() {
+                reply->deleteLater();
+                --m_running;
+                m_downloading.remove(url);
+                m_requesters.remove(url);
+                if (reply->error() == QNetworkReply::NoError) {
+                    const QByteArray data = reply->readAll();
+                    store(url, data);
+                    emit imageAvailable(url, data);
+                } else {
+                    emit imageFailed(url, reply->error());
+                }
+                startDownloads();
+            });
+        }
+    }
+
+    void store(const QUrl &url, const QByteArray &data)
+    {
+        const QByteArray key = urlKey(url);
+        forget(key);
+
+        Entry entry;
+        entry.blob = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+        entry.size = data.size();
+        entry.lastUsed = QDateTime::currentMSecsSinceEpoch();
+        if (m_blobUsers.value(entry.blob) == 0) {
+            QSaveFile file(blobFile(entry.blob));
+            if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+                return;
+            }
+            m_totalSize += entry.size;
+        }
+        ++m_blobUsers[entry.blob];
+        m_entries.insert(key, entry);
+        evict();
+        m_saveTimer.start();
+    }
+
+    void forget(const QByteArray &key)
+    {
+        QHash<QByteArray, Entry>::iterator it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return;
+        }
+        if (--m_blobUsers[it->blob] <= 0) {
+            m_blobUsers.remove(it->blob);
+            QFile::remove(blobFile(it->blob));
+            m_totalSize -= it->size;
+        }
+        m_entries.erase(it);
+        m_saveTimer.start();
+    }
+
+    void evict()
+    {
+        if (m_totalSize <= m_maxSize) {
+            return;
+        }
+        QList<QPair<qint64, QByteArray> > byAge;
+        for (QHash<QByteArray, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            byAge.append(qMakePair(it->lastUsed, it.key()));
+        }
+        std::sort(byAge.begin(), byAge.end());
+        for (int i = 0; i < byAge.size() && m_totalSize > m_maxSize; ++i) {
+            forget(byAge.at(i).second);
+        }
+    }
+
+    void loadIndex()
+    {
+        QFile file(indexFile());
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_6);
+        qint32 version;
+        qint32 count;
+        stream >> version >> count;
+        if (version != IndexVersion) {
+            return;
+        }
+        for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+            QByteArray key;
+            Entry entry;
+            stream >> key >> entry.blob >> entry.size >> entry.lastUsed;
+            if (!QFile::exists(blobFile(entry.blob))) {
+                continue;
+            }
+            if (m_blobUsers.value(entry.blob) == 0) {
+                m_totalSize += entry.size;
+            }
+            ++m_blobUsers[entry.blob];
+            m_entries.insert(key, entry);
+        }
+    }
+
+    void saveIndex()
+    {
+        QSaveFile file(indexFile());
+        if (!file.open(QIODevice::WriteOnly)) {
+            return;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_6);
+        stream << qint32(IndexVersion) << qint32(m_entries.size());
+        for (QHash<QByteArray, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            stream << it.key() << it->blob << it->size << it->lastUsed;
+        }
+        file.commit();
+    }
+
+    const QString m_directory;
+    QNetworkAccessManager m_nam;
+    QPointer<QNetworkAccessManager> m_externalNam;
+    QTimer m_saveTimer;
+    QHash<QByteArray, Entry> m_entries;
+    QHash<QByteArray, int> m_blobUsers;
+    qint64 m_maxSize;
+    qint64 m_totalSize;
+    QList<QUrl> m_queues[Visible + 1];
+    QHash<QUrl, Priority> m_pending;
+    // the number of request() calls waiting for each queued or running download
+    QHash<QUrl, int> m_requesters;
+    QSet<QUrl> m_downloading;
+    int m_maxConcurrentDownloads;
+    int m_running;
+};
+
+}
+
+#endif
@@ -0,0 +1,410 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_PRIVATEDATACACHE_H
+#define ATTICA_PRIVATEDATACACHE_H
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QTimer>
+#include <QUrl>
+
+#include "itemjob.h"
+#include "metadata.h"
+#include "postjob.h"
+#include "privatedata.h"
+#include "provider.h"
+#include "sharedinstances.h"
+
+namespace Attica
+{
+
+/**
+ * A local write-back cache for the PrivateData of one application.
+ *
+ * Reads are answered from memory; the values are kept on disk and only
+ * fetched from the server by fetch(). setValue() changes the local copy
+ * right away and the changed keys are sent with Provider::setPrivateData()
+ * after flushDelay(), so a burst of changes to a key costs one request.
+ *
+ * Before changes are sent, the server's copy is fetched once and
+ * PrivateData::timestamp() is compared with the timestamp the local copy is
+ * based on. If a key was changed on the server meanwhile to a different
+ * value, conflictDetected() is emitted and the newer of both changes is
+ * kept. After each write the key is read back, so the comparison uses the
+ * server's own timestamp; a server value equal to the last value this cache
+ * wrote is never taken for a conflict.
+ */
+class PrivateDataCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// The shared cache of the data of @p app on @p provider, see SharedInstances
+    static PrivateDataCache *forApplication(const Provider &provider, const QString &app)
+    {
+        return SharedInstances<PrivateDataCache, QPair<QUrl, QString> >::instance(qMakePair(provider.baseUrl(), app), [&](QObject *parent) {
+            return new PrivateDataCache(provider, app, QString(), parent);
+        });
+    }
+
+    /**
+     * Restores the values kept in @p fileName.
+     * @param fileName where the values are kept, by default a file in QStandardPaths::AppDataLocation
+     */
+    PrivateDataCache(const Provider &provider, const QString &app, const QString &fileName = QString(), QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_app(app)
+        , m_fileName(fileName.isEmpty() ? defaultFileName(provider, app) : fileName)
+        , m_fetching(false)
+        , m_flushing(false)
+        , m_writesRunning(0)
+    {
+        m_flushTimer.setSingleShot(true);
+        m_flushTimer.setInterval(5000);
+        connect(&m_flushTimer, &QTimer::timeout, this, &PrivateDataCache::flush);
+
+        m_saveTimer.setSingleShot(true);
+        m_saveTimer.setInterval(1000);
+        connect(&m_saveTimer, &QTimer::timeout, this, &PrivateDataCache::save);
+
+        if (QCoreApplication::instance()) {
+            connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &PrivateDataCache::save);
+        }
+
+        load();
+        if (hasPendingChanges()) {
+            m_flushTimer.start();
+        }
+    }
+
+    ~PrivateDataCache() override
+    {
+        if (m_saveTimer.isActive()) {
+            save();
+        }
+    }
+
+    QString application() const { return m_app; }
+
+    /// Milliseconds a change waits before it is sent, 5 seconds by default
+    int flushDelay() const { return m_flushTimer.interval(); }
+    void setFlushDelay(int msecs) { m_flushTimer.setInterval(msecs); }
+
+    bool contains(const QString &key) const { return m_entries.contains(key); }
+    QStringList keys() const { return m_entries.keys(); }
+
+    QString value(const QString &key, const QString &defaultValue = QString()) const
+    {
+        QHash<QString, Entry>::const_iterator it = m_entries.constFind(key);
+        return it == m_entries.constEnd() ? defaultValue : it->value;
+    }
+
+    /// Changes @p key locally; the change is sent after flushDelay()
+    void setValue(const QString &key, const QString &value)
+    {
+        QHash<QString, Entry>::const_iterator known = m_entries.constFind(key);
+        if (known != m_entries.constEnd() && known->value == value) {
+            return;
+        }
+        Entry &entry = m_entries[key];
+        entry.value = value;
+        entry.modified = QDateTime::currentDateTimeUtc();
+        entry.dirty = true;
+        scheduleSave();
+        if (!m_flushTimer.isActive()) {
+            m_flushTimer.start();
+        }
+    }
+
+    /// Whether local changes are waiting to be sent
+    bool hasPendingChanges() const
+    {
+        for (QHash<QString, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            if (it->dirty) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Fetches all values of the application from the server; emits fetched() when done
+    void fetch()
+    {
+        if (m_fetching) {
+            return;
+        }
+        m_fetching = true;
+        ItemJob<PrivateData> *job = m_provider.requestPrivateData(m_app);
+        connect(job, &BaseJob::finished, this, [this](BaseJob *baseJob) {
+            m_fetching = false;
+            const Metadata metadata = baseJob->metadata();
+            if (metadata.error() != Metadata::NoError) {
+                emit fetchFailed(metadata);
+                if (m_flushing) {
+                    m_flushing = false;
+                    retryLater();
+                }
+                return;
+            }
+            merge(static_cast<ItemJob<PrivateData> *>(baseJob)->result());
+            emit fetched();
+            if (m_flushing) {
+                sendChanges();
+            }
+        });
+        job->start();
+    }
+
+    /// Sends the pending changes now, after checking the server's copy for conflicts
+    void flush()
+    {
+        m_flushTimer.stop();
+        if (m_flushing || m_writesRunning > 0 || !hasPendingChanges()) {
+            return;
+        }
+        m_flushing = true;
+        fetch();
+    }
+
+    /// Writes the values and the pending changes to disk
+    bool save()
+    {
+        m_saveTimer.stop();
+        QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+        QSaveFile file(m_fileName);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_6);
+        stream << quint32(Magic) << quint32(Version) << qint32(m_entries.size());
+        for (QHash<QString, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            stream << it.key() << it->value << it->serverTimestamp << it->modified << it->dirty << it->written;
+        }
+        return stream.status() == QDataStream::Ok && file.commit();
+    }
+
+Q_SIGNALS:
+    /// @p key got a different value from the server
+    void valueChanged(const QString &key, const QString &value);
+    /**
+     * @p key was changed both locally and on the server.
+     * The change made later is kept; @p keptLocal tells which one it was.
+     */
+    void conflictDetected(const QString &key, const QString &localValue, const QString &serverValue, bool keptLocal);
+    void fetched();
+    void fetchFailed(const Attica::Metadata &metadata);
+    /// Sending the change of @p key failed; it is retried after flushDelay()
+    void writeFailed(const QString &key, const Attica::Metadata &metadata);
+
+private:
+    enum { Magic = 0x41745064, Version = 2 };
+
+    struct Entry {
+        Entry() : dirty(false) {}
+        QString value;
+        // the server's timestamp of the value the local copy is based on
+        QDateTime serverTimestamp;
+        // when the value was changed locally
+        QDateTime modified;
+        bool dirty;
+        // the value this cache last sent to the server
+        QString written;
+    };
+
+    static QString defaultFileName(const Provider &provider, const QString &app)
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(provider.baseUrl().toEncoded());
+        hash.addData(app.toUtf8());
+        return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+               + QStringLiteral("/attica/privatedata/") + QString::fromLatin1(hash.result().toHex()) + QStringLiteral(".dat");
+    }
+
+    void load()
+    {
+        QFile file(m_fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_6);
+        quint32 magic;
+        quint32 version;
+        qint32 count;
+        stream >> magic >> version >> count;
+        if (magic != Magic || version != Version) {
+            return;
+        }
+        QHash<QString, Entry> entries;
+        for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+            QString key;
+            Entry entry;
+            stream >> key >> entry.value >> entry.serverTimestamp >> entry.modified >> entry.dirty >> entry.written;
+            entries.insert(key, entry);
+        }
+        if (stream.status() == QDataStream::Ok) {
+            m_entries = entries;
+        }
+    }
+
+    void scheduleSave()
+    {
+        if (!m_saveTimer.isActive()) {
+            m_saveTimer.start();
+        }
+    }
+
+    void retryLater()
+    {
+        if (!m_flushTimer.isActive()) {
+            m_flushTimer.start();
+        }
+    }
+
+    void merge(const PrivateData &data)
+    {
+        const QStringList keys = data.keys();
+        for (const QString &key : keys) {
+            const QString serverValue = data.attribute(key);
+            const QDateTime serverTimestamp = data.timestamp(key);
+            Entry &entry = m_entries[key];
+
+            if (!entry.dirty) {
+                entry.serverTimestamp = serverTimestamp;
+                if (entry.value != serverValue) {
+                    entry.value = serverValue;
+                    emit valueChanged(key, serverValue);
+                }
+                continue;
+            }
+
+            if (entry.value == serverValue) {
+                // someone else made the same change, nothing left to send
+                entry.dirty = false;
+                entry.serverTimestamp = serverTimestamp;
+                continue;
+            }
+
+            if (!entry.written.isNull() && entry.written == serverValue) {
+                // the server still has our own previous write, the local change just is newer
+                entry.serverTimestamp = serverTimestamp;
+                continue;
+            }
+
+            const bool changedOnServer = serverTimestamp.isValid()
+                                         && (!entry.serverTimestamp.isValid() || serverTimestamp > entry.serverTimestamp);
+            if (!changedOnServer) {
+                continue;
+            }
+
+            const QString localValue = entry.value;
+            const bool keepLocal = entry.modified >= serverTimestamp;
+            entry.serverTimestamp = serverTimestamp;
+            if (!keepLocal) {
+                entry.value = serverValue;
+                entry.dirty = false;
+            }
+            emit conflictDetected(key, localValue, serverValue, keepLocal);
+            if (!keepLocal) {
+                emit valueChanged(key, serverValue);
+            }
+        }
+        scheduleSave();
+    }
+
+    void sendChanges()
+    {
+        m_flushing = false;
+        for (QHash<QString, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            if (!it->dirty) {
+                continue;
+            }
+            const QString key = it.key();
+            const QString value = it->value;
+            const QDateTime modified = it->modified;
+            ++m_writesRunning;
+
+            PostJob *job = m_provider.setPrivateData(m_app, key, value);
+            connect(job, &BaseJob::finished, this, [this, key, value, modified](BaseJob *baseJob) {
+                --m_writesRunning;
+                const Metadata metadata = baseJob->metadata();
+                QHash<QString, Entry>::iterator entry = m_entries.find(key);
+                if (metadata.error() != Metadata::NoError) {
+                    emit writeFailed(key, metadata);
+                    retryLater();
+                } else if (entry != m_entries.end()) {
+                    entry->written = value;
+                    if (entry->value == value && entry->modified == modified) {
+                        entry->dirty = false;
+                    }
+                    scheduleSave();
+                    // the server sets its own timestamp, which later fetches compare against
+                    refreshKey(key);
+                }
+                // changes made while the write was running
+                if (m_writesRunning == 0 && hasPendingChanges()) {
+                    retryLater();
+                }
+            });
+            job->start();
+        }
+    }
+
+    void refreshKey(const QString &key)
+    {
+        ItemJob<PrivateData> *job = m_provider.requestPrivateData(m_app, key);
+        connect(job, &BaseJob::finished, this, [this](BaseJob *baseJob) {
+            if (baseJob->metadata().error() == Metadata::NoError) {
+                merge(static_cast<ItemJob<PrivateData> *>(baseJob)->result());
+            }
+        });
+        job->start();
+    }
+
+    Provider m_provider;
+    QString m_app;
+    QString m_fileName;
+    QHash<QString, Entry> m_entries;
+    QTimer m_flushTimer;
+    QTimer m_saveTimer;
+    bool m_fetching;
+    bool m_flushing;
+    int m_writesRunning;
+};
+
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_PROVIDERINDEX_H
+#define ATTICA_PROVIDERINDEX_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QVector>
+
+#include "providermanager.h"
+
+namespace Attica
+{
+
+/**
+ * An index over the providers of a ProviderManager.
+ *
+ * providerByUrl() and contains() are a single hash lookup by normalized base
+ * url. providerFor() walks a trie of host and path segments and returns the
+ * provider with the longest base url that is a prefix of the given url, so
+ * its cost depends on the depth of the url, not on the number of providers.
+ *
+ * The index follows ProviderManager::providerAdded(). Call rebuild() after
+ * ProviderManager::clear().
+ */
+class ProviderIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef QHash<QString, Provider>::const_iterator const_iterator;
+
+    explicit ProviderIndex(ProviderManager *manager, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_manager(manager)
+    {
+        connect(manager, &ProviderManager::providerAdded, this, &ProviderIndex::insert);
+        rebuild();
+    }
+
+    /// Drops the index and fills it again from the manager
+    void rebuild()
+    {
+        m_providers.clear();
+        m_roots.clear();
+        m_nodes.clear();
+        const QList<Provider> providers = m_manager->providers();
+        for (const Provider &provider : providers) {
+            insert(provider);
+        }
+    }
+
+    void insert(const Attica::Provider &provider)
+    {
+        const QUrl url = provider.baseUrl();
+        const QString key = normalize(url);
+        m_providers.insert(key, provider);
+
+        int node = addRoot(url);
+        const QStringList segments = pathSegments(url);
+        for (const QString &segment : segments) {
+            int child = m_nodes.at(node).children.value(segment, -1);
+            if (child < 0) {
+                child = m_nodes.size();
+                m_nodes.append(Node());
+                m_nodes[node].children.insert(segment, child);
+            }
+            node = child;
+        }
+        m_nodes[node].key = key;
+    }
+
+    bool contains(const QUrl &baseUrl) const
+    {
+        return m_providers.contains(normalize(baseUrl));
+    }
+
+    /// The provider with exactly the base url @p url
+    Provider providerByUrl(const QUrl &url) const
+    {
+        return m_providers.value(normalize(url));
+    }
+
+    /// The provider responsible for @p url, i.e. the one with the longest base url that is a prefix of it
+    Provider providerFor(const QUrl &url) const
+    {
+        int node = findRoot(url);
+        if (node < 0) {
+            return Provider();
+        }
+        QString key = m_nodes.at(node).key;
+        const QStringList segments = pathSegments(url);
+        for (const QString &segment : segments) {
+            node = m_nodes.at(node).children.value(segment, -1);
+            if (node < 0) {
+                break;
+            }
+            if (!m_nodes.at(node).key.isEmpty()) {
+                key = m_nodes.at(node).key;
+            }
+        }
+        return key.isEmpty() ? Provider() : m_providers.value(key);
+    }
+
+    int count() const { return m_providers.size(); }
+
+    /// Iterate the providers without copying them
+    const_iterator begin() const { return m_providers.constBegin(); }
+    const_iterator end() const { return m_providers.constEnd(); }
+
+    /// The key used for @p url: lower case scheme and host, no default port, query or fragment, trailing slash
+    static QString normalize(const QUrl &url)
+    {
+        QString path = url.path();
+        if (!path.endsWith(QLatin1Char('/'))) {
+            path += QLatin1Char('/');
+        }
+        return authority(url) + path;
+    }
+
+private:
+    struct Node {
+        QHash<QString, int> children;
+        QString key;
+    };
+
+    static QString authority(const QUrl &url)
+    {
+        const QString scheme = url.scheme().toLower();
+        int port = url.port();
+        if ((scheme == QLatin1String("https") && port == 443) || (scheme == QLatin1String("http") && port == 80)) {
+            port = -1;
+        }
+        QString result = scheme + QStringLiteral("://") + url.host().toLower();
+        if (port >= 0) {
+            result += QLatin1Char(':') + QString::number(port);
+        }
+        return result;
+    }
+
+    static QStringList pathSegments(const QUrl &url)
+    {
+        return url.path().split(QLatin1Char('/'), Qt::SkipEmptyParts);
+    }
+
+    int findRoot(const QUrl &url) const
+    {
+        return m_roots.value(authority(url), -1);
+    }
+
+    int addRoot(const QUrl &url)
+    {
+        int node = findRoot(url);
+        if (node < 0) {
+            node = m_nodes.size();
+            m_nodes.append(Node());
+            m_roots.insert(authority(url), node);
+        }
+        return node;
+    }
+
+    ProviderManager *m_manager;
+    QHash<QString, Provider> m_providers;
+    QHash<QString, int> m_roots;
+    QVector<Node> m_nodes;
+};
+
+}
+
+#endif
@@ -0,0 +1,243 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_STATICCATALOGCACHE_H
+#define ATTICA_STATICCATALOGCACHE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QUrl>
+#include <QVector>
+
+#include <algorithm>
+
+#include "category.h"
+#include "distribution.h"
+#include "homepagetype.h"
+#include "license.h"
+#include "provider.h"
+#include "sharedinstances.h"
+
+namespace Attica
+{
+
+/**
+ * Memoizes the nearly static lists of a Provider: categories, licenses,
+ * distributions and home page types.
+ *
+ * There is one cache per provider base url, shared by all copies of the
+ * Provider and all windows of the application; get it with forProvider().
+ * The getters return what is cached right away. If nothing is cached yet or
+ * the data is older than maxAge(), a refresh is started in the background
+ * and the matching changed signal is emitted when it arrives. After a failed
+ * refresh the getters wait before they try again, starting at five seconds
+ * and doubling up to maxAge().
+ *
+ * Licenses, distributions and home page types have small integer ids, so
+ * license(), distribution() and homePageType() are an array index.
+ *
+ * The cache is shared; see SharedInstances for the thread to use it from.
+ */
+class StaticCatalogCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// The cache shared by all copies of @p provider, see SharedInstances
+    static StaticCatalogCache *forProvider(const Provider &provider)
+    {
+        return SharedInstances<StaticCatalogCache>::instance(provider.baseUrl(), [&](QObject *parent) {
+            return new StaticCatalogCache(provider, parent);
+        });
+    }
+
+    /// Seconds after which cached data is refreshed, one day by default
+    qint64 maxAge() const { return m_maxAge; }
+    void setMaxAge(qint64 seconds) { m_maxAge = seconds; }
+
+    Category::List categories()
+    {
+        revalidate(m_categories, &Provider::requestCategories, &StaticCatalogCache::categoriesChanged);
+        return m_categories.items;
+    }
+
+    License::List licenses()
+    {
+        revalidate(m_licenses, &Provider::requestLicenses, &StaticCatalogCache::licensesChanged);
+        return m_licenses.items;
+    }
+
+    Distribution::List distributions()
+    {
+        revalidate(m_distributions, &Provider::requestDistributions, &StaticCatalogCache::distributionsChanged);
+        return m_distributions.items;
+    }
+
+    HomePageType::List homePageTypes()
+    {
+        revalidate(m_homePageTypes, &Provider::requestHomePageTypes, &StaticCatalogCache::homePageTypesChanged);
+        return m_homePageTypes.items;
+    }
+
+    Category category(const QString &id) const
+    {
+        const int position = m_categoryIndex.value(id, -1);
+        return position < 0 ? Category() : m_categories.items.at(position);
+    }
+
+    License license(uint id) const { return m_licenses.find(id); }
+    Distribution distribution(uint id) const { return m_distributions.find(id); }
+    HomePageType homePageType(uint id) const { return m_homePageTypes.find(id); }
+
+    /// Fetches all lists again, regardless of their age
+    void refresh()
+    {
+        fetch(m_categories, &Provider::requestCategories, &StaticCatalogCache::categoriesChanged);
+        fetch(m_licenses, &Provider::requestLicenses, &StaticCatalogCache::licensesChanged);
+        fetch(m_distributions, &Provider::requestDistributions, &StaticCatalogCache::distributionsChanged);
+        fetch(m_homePageTypes, &Provider::requestHomePageTypes, &StaticCatalogCache::homePageTypesChanged);
+    }
+
+Q_SIGNALS:
+    void categoriesChanged();
+    void licensesChanged();
+    void distributionsChanged();
+    void homePageTypesChanged();
+
+private:
+    typedef void (StaticCatalogCache::*ChangedSignal)();
+
+    // ids above this are looked up linearly instead of getting a slot in the dense index
+    enum { MaxDenseId = 65536 };
+    // seconds to wait before the first retry after a failed fetch
+    enum { MinRetryDelay = 5 };
+
+    template <class T>
+    struct Catalog {
+        Catalog() : pending(false), retryDelay(0) {}
+
+        typename T::List items;
+        QDateTime fetched;
+        bool pending;
+        // when the last fetch failed and how many seconds to wait after it
+        QDateTime failed;
+        qint64 retryDelay;
+        // position in items by id, -1 for ids that are not used
+        QVector<int> index;
+
+        T find(uint id) const
+        {
+            if (id < uint(MaxDenseId)) {
+                return id < uint(index.size()) && index.at(id) >= 0 ? items.at(index.at(id)) : T();
+            }
+            for (const T &item : items) {
+                if (item.id() == id) {
+                    return item;
+                }
+            }
+            return T();
+        }
+    };
+
+    StaticCatalogCache(const Provider &provider, QObject *parent)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_maxAge(24 * 60 * 60)
+    {
+    }
+
+    template <class T>
+    void revalidate(Catalog<T> &catalog, ListJob<T> *(Provider::*request)(), ChangedSignal changed)
+    {
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+        if (catalog.failed.isValid() && catalog.failed.secsTo(now) < catalog.retryDelay) {
+            return;
+        }
+        if (!catalog.fetched.isValid() || catalog.fetched.secsTo(now) > m_maxAge) {
+            fetch(catalog, request, changed);
+        }
+    }
+
+    template <class T>
+    void fetch(Catalog<T> &catalog, ListJob<T> *(Provider::*request)(), ChangedSignal changed)
+    {
+        if (catalog.pending) {
+            return;
+        }
+        catalog.pending = true;
+        ListJob<T> *job = (m_provider.*request)();
+        connect(job, &BaseJob::finished, this, [this, &catalog, changed](BaseJob *baseJob) {
+            catalog.pending = false;
+            if (baseJob->metadata().error() != Metadata::NoError) {
+                catalog.failed = QDateTime::currentDateTimeUtc();
+                catalog.retryDelay = qBound(qint64(MinRetryDelay), catalog.retryDelay * 2, qMax(qint64(MinRetryDelay), m_maxAge));
+                return;
+            }
+            catalog.failed = QDateTime();
+            catalog.retryDelay = 0;
+            catalog.items = static_cast<ListJob<T> *>(baseJob)->itemList();
+            catalog.fetched = QDateTime::currentDateTimeUtc();
+            updated(catalog);
+            emit (this->*changed)();
+        });
+        job->start();
+    }
+
+    template <class T>
+    void updated(Catalog<T> &catalog)
+    {
+        catalog.index.clear();
+        for (int i = 0; i < catalog.items.size(); ++i) {
+            const uint id = catalog.items.at(i).id();
+            if (id >= uint(MaxDenseId)) {
+                continue;
+            }
+            if (uint(catalog.index.size()) <= id) {
+                const int oldSize = catalog.index.size();
+                catalog.index.resize(id + 1);
+                std::fill(catalog.index.begin() + oldSize, catalog.index.end(), -1);
+            }
+            catalog.index[id] = i;
+        }
+    }
+
+    void updated(Catalog<Category> &catalog)
+    {
+        m_categoryIndex.clear();
+        for (int i = 0; i < catalog.items.size(); ++i) {
+            m_categoryIndex.insert(catalog.items.at(i).id(), i);
+        }
+    }
+
+    Provider m_provider;
+    qint64 m_maxAge;
+    Catalog<Category> m_categories;
+    Catalog<License> m_licenses;
+    Catalog<Distribution> m_distributions;
+    Catalog<HomePageType> m_homePageTypes;
+    QHash<QString, int> m_categoryIndex;
+};
+
+}
+
+#endif
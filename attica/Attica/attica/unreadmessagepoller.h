@@ -0,0 +1,186 @@
+/*
+    This file is part of KDE.
+
+    Copyright (c) 2026 The Attica developers
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) version 3, or any
+    later version accepted by the membership of KDE e.V. (or its
+    successor approved by the membership of KDE e.V.), which shall
+    act as a proxy defined in Section 6 of version 3 of the license.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef ATTICA_UNREADMESSAGEPOLLER_H
+#define ATTICA_UNREADMESSAGEPOLLER_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+#include "folder.h"
+#include "message.h"
+#include "provider.h"
+
+namespace Attica
+{
+
+/**
+ * Polls the number of unread messages in all folders of a Provider.
+ *
+ * poll() lists the folders and then asks for the unread messages of every
+ * folder at the same time, so a poll takes two round trips however many
+ * folders there are. The count is the total the server reports in
+ * Metadata::totalItems(), not the size of the first page of messages.
+ *
+ * Folders whose Folder::messageCount() did not change since the previous
+ * poll are not asked again and keep their count. That misses messages
+ * read or marked unread on another client, and a deleted message that was
+ * replaced by a new one; call poll(true) to ask all folders.
+ *
+ * folderChanged() is emitted for each folder that is asked again,
+ * folderUnreadCountChanged() for each folder whose count changed and
+ * polled() once all folders have answered. MessageSync builds on this to
+ * decide which folders to list.
+ */
+class UnreadMessagePoller : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit UnreadMessagePoller(const Provider &provider, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_provider(provider)
+        , m_pending(0)
+        , m_polling(false)
+    {
+    }
+
+    bool isPolling() const { return m_polling; }
+
+    void poll(bool force = false)
+    {
+        if (m_polling) {
+            return;
+        }
+        m_polling = true;
+        ListJob<Folder> *job = m_provider.requestFolders();
+        connect(job, &BaseJob::finished, this, [this, force](BaseJob *baseJob) {
+            if (baseJob->metadata().error() != Metadata::NoError) {
+                m_polling = false;
+                emit pollFailed(baseJob->metadata());
+                return;
+            }
+            pollFolders(static_cast<ListJob<Folder> *>(baseJob)->itemList(), force);
+        });
+        job->start();
+    }
+
+    int unreadCount(const QString &folderId) const { return m_folders.value(folderId).unread; }
+
+    /// Applies a change made locally, e.g. reading a message, until the next poll asks the server
+    void adjustUnreadCount(const QString &folderId, int delta)
+    {
+        QHash<QString, FolderState>::iterator it = m_folders.find(folderId);
+        if (it == m_folders.end() || delta == 0) {
+            return;
+        }
+        it->unread = qMax(0, it->unread + delta);
+        emit folderUnreadCountChanged(folderId, it->unread);
+    }
+
+    int unreadCount() const
+    {
+        int count = 0;
+        for (QHash<QString, FolderState>::const_iterator it = m_folders.constBegin(); it != m_folders.constEnd(); ++it) {
+            count += it->unread;
+        }
+        return count;
+    }
+
+Q_SIGNALS:
+    /// The message count of @p folder changed since the previous poll, or the poll was forced
+    void folderChanged(const Attica::Folder &folder);
+    void folderUnreadCountChanged(const QString &folderId, int count);
+    /// All folders have been polled, @p unreadCount is the total over all of them
+    void polled(int unreadCount);
+    void pollFailed(const Attica::Metadata &metadata);
+
+private:
+    struct FolderState {
+        FolderState() : messageCount(-1), unread(0) {}
+        int messageCount;
+        int unread;
+    };
+
+    void pollFolders(const Folder::List &folders, bool force)
+    {
+        QHash<QString, FolderState> previous;
+        previous.swap(m_folders);
+        m_pending = 0;
+        for (const Folder &folder : folders) {
+            FolderState &state = m_folders[folder.id()];
+            state = previous.value(folder.id());
+            if (!force && state.messageCount == folder.messageCount()) {
+                continue;
+            }
+            state.messageCount = folder.messageCount();
+            emit folderChanged(folder);
+
+            ++m_pending;
+            ListJob<Message> *job = m_provider.requestMessages(folder, Message::Unread);
+            const QString folderId = folder.id();
+            connect(job, &BaseJob::finished, this, [this, folderId](BaseJob *baseJob) {
+                Metadata metadata = baseJob->metadata();
+                if (metadata.error() == Metadata::NoError) {
+                    // the listing is only the first page, the total covers the whole folder
+                    const int unread = qMax(metadata.totalItems(), static_cast<ListJob<Message> *>(baseJob)->itemList().size());
+                    FolderState &state = m_folders[folderId];
+                    if (state.unread != unread) {
+                        state.unread = unread;
+                        emit folderUnreadCountChanged(folderId, unread);
+                    }
+                } else {
+                    // ask again next time
+                    m_folders[folderId].messageCount = -1;
+                }
+                if (--m_pending == 0) {
+                    finish();
+                }
+            });
+            job->start();
+        }
+        for (QHash<QString, FolderState>::const_iterator it = previous.constBegin(); it != previous.constEnd(); ++it) {
+            if (!m_folders.contains(it.key()) && it->unread) {
+                emit folderUnreadCountChanged(it.key(), 0);
+            }
+        }
+        if (m_pending == 0) {
+            finish();
+        }
+    }
+
+    void finish()
+    {
+        m_polling = false;
+        emit polled(unreadCount());
+    }
+
+    Provider m_provider;
+    QHash<QString, FolderState> m_folders;
+    int m_pending;
+    bool m_polling;
+};
+
+}
+
+#endif
@@ -9,3 +9,28 @@ LIBS += -L$$PWD/./ -lKF5Attica
 
 INCLUDEPATH += $$PWD/Attica
 DEPENDPATH += $$PWD/Attica
+
+# Header-only helpers. Their moc output is not part of libKF5Attica, so they
+# are listed here to be moc'ed in the consuming project. CMake users need to
+# add them to a target with AUTOMOC enabled or run qt5_wrap_cpp() on them.
+HEADERS += $$PWD/Attica/attica/jobstats.h
+HEADERS += $$PWD/Attica/attica/metricsregistry.h
+HEADERS += $$PWD/Attica/attica/providerfilecache.h
+HEADERS += $$PWD/Attica/attica/providerindex.h
+HEADERS += $$PWD/Attica/attica/contentmirror.h
+HEADERS += $$PWD/Attica/attica/staticcatalogcache.h
+HEADERS += $$PWD/Attica/attica/objectcache.h
+HEADERS += $$PWD/Attica/attica/personregistry.h
+HEADERS += $$PWD/Attica/attica/previewcache.h
+# ThumbnailDecoder needs QtGui
+contains(QT, gui): HEADERS += $$PWD/Attica/attica/thumbnaildecoder.h
+HEADERS += $$PWD/Attica/attica/forumindex.h
+HEADERS += $$PWD/Attica/attica/messagesync.h
+HEADERS += $$PWD/Attica/attica/unreadmessagepoller.h
+HEADERS += $$PWD/Attica/attica/activityfeed.h
+HEADERS += $$PWD/Attica/attica/buildoutputtail.h
+HEADERS += $$PWD/Attica/attica/buildjobmonitor.h
+HEADERS += $$PWD/Attica/attica/achievementprogressqueue.h
+HEADERS += $$PWD/Attica/attica/votebuffer.h
+HEADERS += $$PWD/Attica/attica/privatedatacache.h
+HEADERS += $$PWD/Attica/attica/locationcache.h